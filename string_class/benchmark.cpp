@@ -0,0 +1,67 @@
+//#define STR_USE_COW               /* define this to let copies share their buffers (copy-on-write) */
+
+#include <stdio.h>  /* include this for output functions */
+#include <time.h>   /* include this for time measuring */
+#include "string.h" /* include string library */
+
+/*
+*** small benchmarks of string_base<T>
+*** build it once with and once without STR_USE_COW (or another setting) 
+defined and compare the times, e.g.
+	g++ -O2 benchmark.cpp -o bench && ./bench
+	g++ -O2 -DSTR_USE_COW benchmark.cpp -o bench_cow && ./bench_cow
+*/
+
+static double seconds(clock_t start) { return (double)(clock() - start) / CLOCKS_PER_SEC; }
+
+/* fan-out: one message is copied to many consumers, only a few of them modify it */
+static void bench_fanout(unsigned size, unsigned consumers, unsigned rounds, unsigned modify_every) {
+	str::string msg('x', size);
+	str::string *out = new str::string[consumers];
+	unsigned check = 0;
+
+	clock_t start = clock();
+	for (unsigned r = 0; r < rounds; r++) {
+		msg[r % size] = (char)('a' + r % 26);
+		for (unsigned i = 0; i < consumers; i++) {
+			out[i] = msg;
+			if (modify_every && i % modify_every == 0) out[i].append('!');
+			check += out[i].length();
+		}
+	}
+	printf("fan-out   %6u chars x %5u copies x %4u rounds, ", size, consumers, rounds);
+	if (modify_every) printf("1/%-2u modified: %8.3f s  [%u]\n", modify_every, seconds(start), check);
+	else printf("none modified: %8.3f s  [%u]\n", seconds(start), check);
+	delete[] out;
+}
+
+/* pass by value: every call copies the string, the callee only reads it */
+static unsigned count_char(str::string s, char ch) {
+	unsigned n = 0;
+	for (unsigned i = s.find(ch); i < s.length(); i = s.find(ch, i + 1)) n++;
+	return n;
+}
+static void bench_by_value(unsigned size, unsigned calls) {
+	str::string text('-', size);
+	text[size / 2] = '+';
+	unsigned check = 0;
+
+	clock_t start = clock();
+	for (unsigned i = 0; i < calls; i++) check += count_char(text, '+');
+	printf("by value  %6u chars x %5u calls:                             %8.3f s  [%u]\n", size, calls, seconds(start), check);
+}
+
+int main() {
+#ifdef STR_USE_COW
+	printf("STR_USE_COW defined\n");
+#else
+	printf("STR_USE_COW not defined\n");
+#endif
+	bench_fanout(64, 1000, 2000, 0);
+	bench_fanout(1024, 1000, 2000, 0);
+	bench_fanout(1024, 1000, 2000, 10);
+	bench_fanout(65536, 100, 200, 0);
+	bench_fanout(65536, 100, 200, 2);
+	bench_by_value(4096, 200000);
+	return 0;
+}
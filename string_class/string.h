@@ -99,6 +99,40 @@
 	Added STR_CPP11_OR_HIGHER to check whether C++11 or higher is supported
 ***1.8:
 	Added bindings to std::basic_istream and std::basic_ostream 
+***1.9:
+	Added small string optimization (STR_SSOSIZE), short strings are stored inside the object
+	assign() reuses the current buffer if possible, clear() and substr() don't reallocate anymore
+	Fixed append() substring overloads writing to the beginning of the buffer
+	Fixed reserve() writing behind the buffer and >> truncating input to the capacity
+	Added move constructor and move assignment (C++11 or higher)
+	swap() exchanges buffers in constant time now
+	Added growth policies (growth_geometric, growth_fixed, growth_page) as third template parameter
+		-> strings grow geometrically by default now (STR_DEFGROWTH), STR_ALLOC is only used by growth_fixed
+	Added allocator support (allocator, alloc_traits) as second template parameter, string_base<T, Alloc, Growth>
+		-> every allocation, reallocation and deallocation goes through the allocator (no more new[] mixed with realloc())
+	Added str::arena (monotonic memory arena) and arena_allocator, arena_string, arena_wstring, ... 
+	find() for single chars uses SSE2 / AVX2 now (define STR_NO_SIMD to disable it), added rfind() for single chars
+	find() for substrings runs in linear time now (SIMD first/last char filter, Two-Way for long needles)
+	Added searcher<T>, a precompiled needle for repeated find(), find_all(), count() and contains()
+	Added multi_searcher<T> (Aho-Corasick with SIMD prefilter), finds a whole set of needles in one pass
+	Added replace_all() (single pass, at most one reallocation), replace() for chars uses SSE2 now
+	remove() runs in linear time now (SSSE3 compaction), added remove_any() and remove_if()
+	compare() uses the stored lengths now (binary-safe, SIMD mismatch search), == and != compare lengths first
+	Added hash() (wyhash), str::hash_bytes() and std::hash<> specializations, optional hash cache (STR_CACHEHASH)
+	Added string_view_base<T> (string_view, wstring_view, ...), view() slices a string without copying
+	Added rope<T> (balanced tree of chunks, see STR_ROPECHUNK) for O(log n) edits of large documents
+	Added gap_buffer<T> for cursor-local editing (amortized O(1) inserts and erases at the cursor)
+	Added optional copy-on-write (STR_USE_COW), copies share heap buffers with atomic reference counts
+	Added intern_pool<T> (sharded, thread-safe string interning) and interned_base<T> handles with O(1) == and hash()
+	Added parse() and str::parse_number() (from_chars()-like, no allocation, SWAR digits, Eisel-Lemire floats)
+		-> stol(), stod(), ... parse in place now (no more new[] and no read behind the string), 
+		stof(), stod() and stold() still accept hexadecimal floats like strtod()
+	Added append_number() and from_number() (digit pairs for integers, Ryu shortest round-trip for float and double)
+	Added operator+ (lazy concat<T, L, R> expressions, the result is allocated exactly once)
+	Added string_builder<T> (chain of chunks, see STR_BUILDERCHUNK) for streaming output, str() joins it with one allocation
+	Added split() and split_any() (lazy splitter<T> yielding views, SIMD delimiter masks), the tokenizer from the TODO list
+	Added ifind(), icompare(), iequals() and ihash() (ASCII case folded inside the SIMD kernels), case-insensitive finding from the TODO list
+	Added utf_length(), utf_convert(), assign_utf() and append_utf() (validated UTF-8/16/32 transcoding, SSSE3 UTF-8 validation, one allocation)
 
 */
 
@@ -107,8 +141,6 @@
 === TODO								   ===
 === ? - thinking of						   ===
 ==============================================
-tokenizer ? (1.8)
-case sensitive finding ? (1.9)
 */ 
 
 
@@ -131,11 +163,15 @@ case sensitive finding ? (1.9)
 *** such as memcpy(), memset() and memmove()
 */
 #include <memory.h> /* for memmove(), memcpy() */
-#include <stdlib.h> /* include stdlib.h for realloc() function */
+#include <stdlib.h> /* include stdlib.h for malloc(), realloc() and free() */
 /* define STR_USE_ASSERTIONS somewhere in your code to enable assertions */
 #ifdef STR_USE_ASSERTIONS 
 	#include <assert.h> /* for assert() */
 #endif
+/* _InterlockedIncrement() and _InterlockedDecrement() for STR_USE_COW */
+#if defined(STR_USE_COW) && defined(_MSC_VER)
+	#include <intrin.h>
+#endif
 
 /*
 *** define bindings to std::string and std::basic_ostream
@@ -145,6 +181,38 @@ case sensitive finding ? (1.9)
 *** Added with Version 1.4
 */
 
+/* std::move() for the move constructor and move assignment, std::hash<> */
+#ifdef STR_CPP11_OR_HIGHER
+	#include <utility>
+	#include <functional>
+	#include <mutex>	/* std::mutex for str::intern_pool */
+#endif
+
+/*
+*** SIMD support for the search functions
+*** SSE2 is used on every x86/x64 compiler supporting it, SSSE3 and AVX2 if the 
+compiler targets them (e.g. -mssse3, -mavx2 or /arch:AVX2)
+*** define STR_NO_SIMD to use plain loops only
+*** Added with Version 1.9
+*/
+#ifndef STR_NO_SIMD
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define STR_SSE2
+		#include <emmintrin.h>	/* SSE2 intrinsics */
+	#endif
+	#if defined(STR_SSE2) && (defined(__SSSE3__) || defined(__AVX2__))
+		#define STR_SSSE3
+		#include <tmmintrin.h>	/* SSSE3 intrinsics (pshufb) */
+	#endif
+	#if defined(STR_SSE2) && defined(__AVX2__)
+		#define STR_AVX2
+		#include <immintrin.h>	/* AVX2 intrinsics */
+	#endif
+	#if defined(_MSC_VER)
+		#include <intrin.h>		/* _BitScanForward(), _BitScanReverse() */
+	#endif
+#endif
+
 #ifdef STR_USE_BINDINGS 
 	#include <string>		/* bindings to std::basic_string */
 	#include <iostream>		/* bindings to std::basic_istream and std::basic_ostream */
@@ -152,29 +220,131 @@ case sensitive finding ? (1.9)
 
 /* 
 *** default string capacity;
-*** (for standard constructor and so on) [def: 32] 
+*** (minimum capacity of the first heap allocation) [def: 32] 
 *** Version 1.1: def(8) -> def(32)
+*** Version 1.9: the standard constructor uses the inline buffer now (see STR_SSOSIZE)
 */
 #define STR_DEFSTRCAP 32
 
+/*
+*** size of the inline buffer in bytes (small string optimization) [def: 16]
+*** strings whose chars (null-terminator included) fit into 
+STR_SSOSIZE bytes are stored inside the object and never touch the heap
+*** holds at least one char (the null-terminator) for every T
+*** define it before including this library to change it
+*** Added with Version 1.9
+*/
+#ifndef STR_SSOSIZE
+	#define STR_SSOSIZE 16
+#endif
+
 /*
 *** DEF_LARGESTRING is a setting to optimize 
 capacity allocation for large or for smaller strings 
 *** allocate DEF_ALLOC * sizeof(T) more space if required
-(It's a high number to minimize reallocations in program) [def: 8192 or 16384] */
+(It's a high number to minimize reallocations in program) [def: 8192 or 16384] 
+*** Version 1.9: only used by str::growth_fixed<> (see STR_DEFGROWTH) */
 #ifdef STR_LARGESTRING 
 	#define STR_ALLOC 16384
 #else
 	#define STR_ALLOC 8192
 #endif
 
+/*
+*** default growth policy of string_base<T> [def: str::growth_geometric<3, 2>]
+*** define it as str::growth_fixed<> to get the behavior of version 1.8 and older
+*** define it before including this library to change it
+*** Added with Version 1.9
+*/
+#ifndef STR_DEFGROWTH
+	#define STR_DEFGROWTH str::growth_geometric<3, 2>
+#endif
+
+/*
+*** default chunk size of str::arena in bytes [def: 65536]
+*** allocations larger than a chunk get a chunk of their own
+*** define it before including this library to change it
+*** Added with Version 1.9
+*/
+#ifndef STR_ARENACHUNK
+	#define STR_ARENACHUNK 65536
+#endif
+
+/*
+*** maximum number of chars in one chunk of str::rope<T> [def: 2048]
+*** edits copy at most two chunks, smaller chunks make edits cheaper 
+and the tree deeper
+*** define it before including this library to change it
+*** Added with Version 1.9
+*/
+#ifndef STR_ROPECHUNK
+	#define STR_ROPECHUNK 2048
+#endif
+
+/*
+*** number of shards of a str::intern_pool<T> [def: 16]
+*** every shard has its own lock, more shards let more threads 
+intern values at the same time, but cost memory for tables and arenas
+*** define it before including this library to change it
+*** Added with Version 1.9
+*/
+#ifndef STR_INTERNSHARDS
+	#define STR_INTERNSHARDS 16
+#endif
+
+/*
+*** define STR_CACHEHASH before including this library to let string_base<T> 
+cache its hash value (see string_base<T>::hash()), every mutation invalidates it
+*** costs 16 bytes per string object
+*** Added with Version 1.9
+*/
+
+/*
+*** define STR_USE_COW before including this library to let copies of a 
+string_base<T> share its heap buffer (copy-on-write)
+*** copying a heap string (copy constructor, assign(), =) only increments an 
+atomic reference count; the first mutating call on a copy (append(), insert(), 
+non-const operator[], data(), begin(), ...) copies the buffer ("detaches"), 
+calls that end up changing nothing (append(""), replace_all() without a 
+match, ...) keep sharing it
+*** strings shorter than STR_COWSIZE bytes are always copied, sharing 
+them costs more (atomic counting) than copying their chars
+*** every heap buffer starts with a reference count (sizeof(long), rounded up 
+to whole chars), so allocators have to return memory aligned for long; buffers 
+are only shared between strings whose allocators compare equal (==)
+*** pointers and references obtained from non-const accessors are only valid 
+until the string is copied, writes through them afterwards affect all copies
+*** Added with Version 1.9
+*/
+
+/*
+*** minimum size of a string value (in bytes) for STR_USE_COW to 
+share its buffer instead of copying it [def: 256]
+*** define it before including this library to change it
+*** Added with Version 1.9
+*/
+#ifndef STR_COWSIZE
+	#define STR_COWSIZE 256
+#endif
+
+/*
+*** number of chars in one chunk of str::string_builder<T> [def: 4096]
+*** larger chunks mean less allocations and less chunks to write out, 
+but more memory for builders holding short values
+*** define it before including this library to change it
+*** Added with Version 1.9
+*/
+#ifndef STR_BUILDERCHUNK
+	#define STR_BUILDERCHUNK 4096
+#endif
+
 /* 
 *** string version;
 *** can be used to check compatibility or for an outdated version 
 *** Macro added with version 1.1
 *** Is changed on new release
 */
-#define STR_VERSION "1.8" 
+#define STR_VERSION "1.9" 
 
 /* define NULL macro if it's not defined by default */
 #ifndef NULL
@@ -214,1938 +384,7757 @@ namespace str {
 	#endif
 #endif
 
-	/* TEMPLATE CLASS string_base<T> */
-	template <typename T>
-	class string_base {
-	public:
-		typedef T *iterator;						/* normal iterator type */
-		typedef const T *const_iterator;			/* const iterator type */
-		typedef T &reference;						/* normal reference type */
-		typedef const T &const_reference;			/* const reference type */
-#ifdef STR_USE_BINDINGS
-		typedef std::basic_string<T, 
-			std::char_traits<T>, 
-			std::allocator<T> > std_string;			/* std::string typedef */
+	/*
+	*********************************************************************
+	*** SIMD kernels												  ***
+	*********************************************************************
+	*** search loops used by string_base<T>, working on 1-, 2- and 4-byte chars
+	*** only read inside the given range (unaligned loads plus a scalar 
+	tail), so they never touch memory behind the end of a buffer
+	*** fall back to plain loops if SIMD is not available (see STR_NO_SIMD)
+	*** Added with Version 1.9
+	*/
+	namespace simd {
+		/* index of the lowest set bit ("x" must not be 0) */
+		inline unsigned lowest_bit(unsigned x) {
+#if defined(_MSC_VER)
+			unsigned long r; _BitScanForward(&r, x); return (unsigned)r;
+#else
+			return (unsigned)__builtin_ctz(x);
 #endif
+		}
+		/* index of the highest set bit ("x" must not be 0) */
+		inline unsigned highest_bit(unsigned x) {
+#if defined(_MSC_VER)
+			unsigned long r; _BitScanReverse(&r, x); return (unsigned)r;
+#else
+			return 31U - (unsigned)__builtin_clz(x);
+#endif
+		}
+
+		template <unsigned N> struct width {};	/* tag type to select kernels by sizeof(T) */
+
+#ifdef STR_SSE2
+		/* broadcast a char to all lanes of a 16-byte vector */
+		inline __m128i splat(unsigned ch, width<1>) { return _mm_set1_epi8((char)ch); }
+		inline __m128i splat(unsigned ch, width<2>) { return _mm_set1_epi16((short)ch); }
+		inline __m128i splat(unsigned ch, width<4>) { return _mm_set1_epi32((int)ch); }
+		/* compare lane-wise for equality */
+		inline __m128i cmpeq(__m128i a, __m128i b, width<1>) { return _mm_cmpeq_epi8(a, b); }
+		inline __m128i cmpeq(__m128i a, __m128i b, width<2>) { return _mm_cmpeq_epi16(a, b); }
+		inline __m128i cmpeq(__m128i a, __m128i b, width<4>) { return _mm_cmpeq_epi32(a, b); }
+		/* byte mask of equal lanes of the 16 bytes at "p" */
+		template <typename T>
+		inline unsigned eq_mask(const T *p, __m128i v) {
+			return (unsigned)_mm_movemask_epi8(cmpeq(_mm_loadu_si128((const __m128i *)p), v, width<sizeof(T)>()));
+		}
+#endif
+#ifdef STR_AVX2
+		/* broadcast a char to all lanes of a 32-byte vector */
+		inline __m256i splat256(unsigned ch, width<1>) { return _mm256_set1_epi8((char)ch); }
+		inline __m256i splat256(unsigned ch, width<2>) { return _mm256_set1_epi16((short)ch); }
+		inline __m256i splat256(unsigned ch, width<4>) { return _mm256_set1_epi32((int)ch); }
+		/* compare lane-wise for equality */
+		inline __m256i cmpeq(__m256i a, __m256i b, width<1>) { return _mm256_cmpeq_epi8(a, b); }
+		inline __m256i cmpeq(__m256i a, __m256i b, width<2>) { return _mm256_cmpeq_epi16(a, b); }
+		inline __m256i cmpeq(__m256i a, __m256i b, width<4>) { return _mm256_cmpeq_epi32(a, b); }
+		/* byte mask of equal lanes of the 32 bytes at "p" */
+		template <typename T>
+		inline unsigned eq_mask(const T *p, __m256i v) {
+			return (unsigned)_mm256_movemask_epi8(cmpeq(_mm256_loadu_si256((const __m256i *)p), v, width<sizeof(T)>()));
+		}
+#endif
+
 		/*
-		*** string_base<T>()
-		*** standard contructor
-		*** allocates DEF_STRCAP (def: 32) spaces for 
-		chars and sets the first one to 0x00
-		*** is pretty much the standard allocation state
-		*** use reset() to restore these settings
-		*/
-		explicit string_base<T>()
-			: len(0), cap(STR_DEFSTRCAP) {
-			raw_data = new T[STR_DEFSTRCAP];
-			raw_data[0] = 0x00;
-		} 
-		/*
-		*** string_base<T>(unsigned)
-		*** constructor to allocate "capacity" spaces by default
-		*** sets first character to 0x00 (null-terminator)
+		*** unsigned find_char(const T *, unsigned, T)
+		*** returns index of the first "ch" within the first "n" chars of "s", or "n" if not found
 		*/
-		explicit string_base<T>(unsigned capacity)
-			: len(0), cap(capacity) {
-			raw_data = new T[cap];
-			raw_data[0] = 0x00;
+		template <typename T>
+		unsigned find_char(const T *s, unsigned n, T ch) {
+			unsigned i = 0;
+#ifdef STR_AVX2
+			const unsigned step2 = 32 / sizeof(T);
+			const __m256i v2 = splat256((unsigned)ch, width<sizeof(T)>());
+			for (; i + 2 * step2 <= n; i += 2 * step2) {
+				unsigned m = eq_mask(s + i, v2);
+				if (m) return i + lowest_bit(m) / sizeof(T);
+				m = eq_mask(s + i + step2, v2);
+				if (m) return i + step2 + lowest_bit(m) / sizeof(T);
+			}
+#endif
+#ifdef STR_SSE2
+			const unsigned step = 16 / sizeof(T);
+			const __m128i v = splat((unsigned)ch, width<sizeof(T)>());
+			for (; i + step <= n; i += step) {
+				unsigned m = eq_mask(s + i, v);
+				if (m) return i + lowest_bit(m) / sizeof(T);
+			}
+#endif
+			for (; i < n; i++)
+				if (s[i] == ch) return i;
+			return n;
 		}
 		/*
-		*** string_base<T>(const T &, unsigned)
-		*** fill constructor
-		*** fill the freshly allocated string 
-		with specified char "ch" ("count" times)
-		*** allocates ("count" + 1) places
-		*** sets last char to 0x00 to finish string
+		*** unsigned rfind_char(const T *, unsigned, T)
+		*** returns index of the last "ch" within the first "n" chars of "s", or "n" if not found
 		*/
-		string_base<T>(const T &ch, unsigned count)
-			: len(count), cap(count + 1) {
-			raw_data = new T[cap];
-			for (unsigned i = 0; i < count; i++)
-				raw_data[i] = ch;
-			raw_data[len] = 0x00;
+		template <typename T>
+		unsigned rfind_char(const T *s, unsigned n, T ch) {
+			unsigned i = n;
+#ifdef STR_AVX2
+			const unsigned step2 = 32 / sizeof(T);
+			const __m256i v2 = splat256((unsigned)ch, width<sizeof(T)>());
+			while (i >= step2) {
+				i -= step2;
+				unsigned m = eq_mask(s + i, v2);
+				if (m) return i + highest_bit(m) / sizeof(T);
+			}
+#endif
+#ifdef STR_SSE2
+			const unsigned step = 16 / sizeof(T);
+			const __m128i v = splat((unsigned)ch, width<sizeof(T)>());
+			while (i >= step) {
+				i -= step;
+				unsigned m = eq_mask(s + i, v);
+				if (m) return i + highest_bit(m) / sizeof(T);
+			}
+#endif
+			while (i-- > 0)
+				if (s[i] == ch) return i;
+			return n;
 		}
 		/*
-		*** string_base<T>(const T *)
-		*** constructor to assign a C-String
-		*** copies "str" in current string
-		*** automatically inserts null-terminator at the end
+		*** void replace_char(T *, unsigned, T, T)
+		*** replaces every "from" within the first "n" chars of "s" with "to"
 		*/
-		string_base<T>(const T *c_str)
-			: len(strlength<T>(c_str)), cap(len + 1) {
-			raw_data = new T[cap];
-			memcpy(raw_data, c_str, len * sizeof(T));
-			raw_data[len] = 0x00;
+		template <typename T>
+		void replace_char(T *s, unsigned n, T from, T to) {
+			unsigned i = 0;
+#ifdef STR_SSE2
+			const unsigned step = 16 / sizeof(T);
+			const __m128i f = splat((unsigned)from, width<sizeof(T)>());
+			const __m128i t = splat((unsigned)to, width<sizeof(T)>());
+			for (; i + step <= n; i += step) {
+				__m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+				__m128i e = cmpeq(v, f, width<sizeof(T)>());
+				if (_mm_movemask_epi8(e))
+					_mm_storeu_si128((__m128i *)(s + i), _mm_or_si128(_mm_and_si128(e, t), _mm_andnot_si128(e, v)));
+			}
+#endif
+			for (; i < n; i++)
+				if (s[i] == from) s[i] = to;
 		}
+
 		/*
-		*** string_base<T>(const T *, unsigned)
-		*** constructor to copy first "len" chars of c_str's value in current string
-		*** automatically inserts null-terminator at the end 
-		*** Version: 1.3.5: Added this contructor
+		*** unsigned mismatch(const T *, const T *, unsigned)
+		*** returns index of the first position at which "a" and "b" differ 
+		within their first "n" chars, or "n" if they are equal
 		*/
-		string_base<T>(const T *c_str, unsigned len) {
-			this->len = MIN(len, strlength<T>(c_str));
-			cap = this->len + 1;
-			raw_data = new T[cap];
-			memcpy(raw_data, c_str, this->len * sizeof(T));
-			raw_data[this->len] = 0x00;
+		template <typename T>
+		unsigned mismatch(const T *a, const T *b, unsigned n) {
+			unsigned i = 0;
+#ifdef STR_AVX2
+			const unsigned step2 = 32 / sizeof(T);
+			for (; i + step2 <= n; i += step2) {
+				__m256i e = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(a + i)), _mm256_loadu_si256((const __m256i *)(b + i)));
+				unsigned m = ~(unsigned)_mm256_movemask_epi8(e);
+				if (m) return i + lowest_bit(m) / sizeof(T);
+			}
+#endif
+#ifdef STR_SSE2
+			const unsigned step = 16 / sizeof(T);
+			for (; i + step <= n; i += step) {
+				__m128i e = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i)));
+				unsigned m = ~(unsigned)_mm_movemask_epi8(e) & 0xFFFF;
+				if (m) return i + lowest_bit(m) / sizeof(T);
+			}
+#endif
+			for (; i < n; i++)
+				if (a[i] != b[i]) return i;
+			return n;
 		}
+
 		/*
-		*** string_base<T>(const string_base<T> &)
-		*** copy constructor
-		*** just copy "obj" in current value
-		*** also copy allocated state (allocate same amount of space as in "str")
-		*** automatically inserts null-terminator at the end
+		*** ASCII case folding
+		*** 'A' - 'Z' compare equal to 'a' - 'z', every other code unit (every 
+		value above 0x7F included) compares by its value only: there is no 
+		locale and no Unicode case mapping, so the Latin-1 umlauts 0xC4 and 0xE4 differ
+		*** UTF-8 and UTF-16 never use ASCII values inside multi-unit sequences, 
+		so ASCII letters of encoded text fold correctly and the rest of the 
+		text has to match exactly (fold with a Unicode library beforehand if 
+		other scripts have to match case-insensitively)
 		*/
-		string_base<T>(const string_base<T> &obj)
-			: len(obj.len), cap(obj.cap) {
-			raw_data = new T[cap];
-			memcpy(raw_data, obj.raw_data, len * sizeof(T));
-			raw_data[len] = 0x00;
+		template <typename T>
+		inline T fold(T c) { return (c >= T('A') && c <= T('Z')) ? T(c | 0x20) : c; }
+		/* the other direction, upper case of 'a' - 'z' */
+		template <typename T>
+		inline T upper(T c) { return (c >= T('a') && c <= T('z')) ? T(c & ~0x20) : c; }
+#ifdef STR_SSE2
+		/* folds the lanes of a 16-byte vector (a lane is a letter if lane - 'A' + MIN < MIN + 26) */
+		inline __m128i fold(__m128i v, width<1>) {
+			__m128i up = _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - 'A'))), _mm_set1_epi8((char)(0x80 + 26)));
+			return _mm_or_si128(v, _mm_and_si128(up, _mm_set1_epi8(0x20)));
 		}
-#ifdef STR_USE_BINDINGS
+		inline __m128i fold(__m128i v, width<2>) {
+			__m128i up = _mm_cmplt_epi16(_mm_add_epi16(v, _mm_set1_epi16((short)(0x8000 - 'A'))), _mm_set1_epi16((short)(0x8000 + 26)));
+			return _mm_or_si128(v, _mm_and_si128(up, _mm_set1_epi16(0x20)));
+		}
+		inline __m128i fold(__m128i v, width<4>) {
+			__m128i up = _mm_cmplt_epi32(_mm_add_epi32(v, _mm_set1_epi32((int)(0x80000000U - 'A'))), _mm_set1_epi32((int)(0x80000000U + 26)));
+			return _mm_or_si128(v, _mm_and_si128(up, _mm_set1_epi32(0x20)));
+		}
+		/* byte mask of the lanes of the 16 bytes at "p" equal to "lower" or "upper" (both cases of a char) */
+		template <typename T>
+		inline unsigned ieq_mask(const T *p, __m128i lower, __m128i upper) {
+			__m128i v = _mm_loadu_si128((const __m128i *)p);
+			return (unsigned)_mm_movemask_epi8(_mm_or_si128(cmpeq(v, lower, width<sizeof(T)>()), cmpeq(v, upper, width<sizeof(T)>())));
+		}
+#endif
+#ifdef STR_AVX2
+		/* folds the lanes of a 32-byte vector */
+		inline __m256i fold(__m256i v, width<1>) {
+			__m256i up = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - 'A'))));
+			return _mm256_or_si256(v, _mm256_and_si256(up, _mm256_set1_epi8(0x20)));
+		}
+		inline __m256i fold(__m256i v, width<2>) {
+			__m256i up = _mm256_cmpgt_epi16(_mm256_set1_epi16((short)(0x8000 + 26)), _mm256_add_epi16(v, _mm256_set1_epi16((short)(0x8000 - 'A'))));
+			return _mm256_or_si256(v, _mm256_and_si256(up, _mm256_set1_epi16(0x20)));
+		}
+		inline __m256i fold(__m256i v, width<4>) {
+			__m256i up = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(0x80000000U + 26)), _mm256_add_epi32(v, _mm256_set1_epi32((int)(0x80000000U - 'A'))));
+			return _mm256_or_si256(v, _mm256_and_si256(up, _mm256_set1_epi32(0x20)));
+		}
+		template <typename T>
+		inline unsigned ieq_mask(const T *p, __m256i lower, __m256i upper) {
+			__m256i v = _mm256_loadu_si256((const __m256i *)p);
+			return (unsigned)_mm256_movemask_epi8(_mm256_or_si256(cmpeq(v, lower, width<sizeof(T)>()), cmpeq(v, upper, width<sizeof(T)>())));
+		}
+#endif
 		/*
-		*** string_base<T>(const std_string &)
-		*** copy content from std::basic_string classes
-		*** copies allocated state as well
-		*** automatically inserts null-terminator at the end
-		*** Added with Version 1.4
+		*** unsigned imismatch(const T *, const T *, unsigned)
+		*** like mismatch(), but ASCII letters are compared without case (both 
+		blocks are folded in the vector registers, nothing is copied)
 		*/
-		string_base<T>(const std_string &obj) 
-			: len(obj.length()), cap(obj.capacity()) {
-			raw_data = new T[cap];
-			memcpy(raw_data, obj.c_str(), len * sizeof(T));
-			raw_data[len] = 0x00;
-		}
+		template <typename T>
+		unsigned imismatch(const T *a, const T *b, unsigned n) {
+			unsigned i = 0;
+#ifdef STR_AVX2
+			const unsigned step2 = 32 / sizeof(T);
+			for (; i + step2 <= n; i += step2) {
+				__m256i x = fold(_mm256_loadu_si256((const __m256i *)(a + i)), width<sizeof(T)>());
+				__m256i y = fold(_mm256_loadu_si256((const __m256i *)(b + i)), width<sizeof(T)>());
+				unsigned m = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+				if (m) return i + lowest_bit(m) / sizeof(T);
+			}
 #endif
+#ifdef STR_SSE2
+			const unsigned step = 16 / sizeof(T);
+			for (; i + 2 * step <= n; i += 2 * step) {	/* two blocks per test */
+				__m128i e0 = _mm_cmpeq_epi8(fold(_mm_loadu_si128((const __m128i *)(a + i)), width<sizeof(T)>()), fold(_mm_loadu_si128((const __m128i *)(b + i)), width<sizeof(T)>()));
+				__m128i e1 = _mm_cmpeq_epi8(fold(_mm_loadu_si128((const __m128i *)(a + i + step)), width<sizeof(T)>()), fold(_mm_loadu_si128((const __m128i *)(b + i + step)), width<sizeof(T)>()));
+				if (_mm_movemask_epi8(_mm_and_si128(e0, e1)) != 0xFFFF) break;
+			}
+			for (; i + step <= n; i += step) {
+				__m128i x = fold(_mm_loadu_si128((const __m128i *)(a + i)), width<sizeof(T)>());
+				__m128i y = fold(_mm_loadu_si128((const __m128i *)(b + i)), width<sizeof(T)>());
+				unsigned m = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & 0xFFFF;
+				if (m) return i + lowest_bit(m) / sizeof(T);
+			}
+#endif
+			for (; i < n; i++)
+				if (fold(a[i]) != fold(b[i])) return i;
+			return n;
+		}
 		/*
-		*** string_base<T>(const string_base<T> &, unsigned, unsigned)
-		*** constructor to assign substring of "str" to current value 
-		(starting at position "start2 with a length of "count")
-		*** allocate ("count" + 1) spaces for substring
-		*** automatically inserts null-terminator at the end
-		*** if "start" is greater than str's length, then start = 0
-		*** Version 1.2: Optimizing, using memcpy() now
-		*** Version 1.2: fix crash when "start" is greater than str's length
+		*** unsigned ifind_char(const T *, unsigned, T)
+		*** like find_char(), but finds both cases of an ASCII letter
 		*/
-		explicit string_base<T>(const string_base<T> &str, unsigned start, unsigned count) {
-			unsigned l = str.len;
-			if (start > l) start = 0;
-			if ((start + count) > l) 
-				count = (l - start);
-			len = count; cap = len + 1;
-			raw_data = new T[cap];
-			memcpy(raw_data, str.raw_data + start, count * sizeof(T));
-			raw_data[len] = 0x00;
+		template <typename T>
+		unsigned ifind_char(const T *s, unsigned n, T ch) {
+			const T lower = fold(ch), up = upper(ch);
+			if (lower == up) return find_char(s, n, ch);
+			unsigned i = 0;
+#ifdef STR_AVX2
+			const unsigned step2 = 32 / sizeof(T);
+			const __m256i l2 = splat256((unsigned)lower, width<sizeof(T)>()), u2 = splat256((unsigned)up, width<sizeof(T)>());
+			for (; i + step2 <= n; i += step2) {
+				unsigned m = ieq_mask(s + i, l2, u2);
+				if (m) return i + lowest_bit(m) / sizeof(T);
+			}
+#endif
+#ifdef STR_SSE2
+			const unsigned step = 16 / sizeof(T);
+			const __m128i l = splat((unsigned)lower, width<sizeof(T)>()), u = splat((unsigned)up, width<sizeof(T)>());
+			for (; i + step <= n; i += step) {
+				unsigned m = ieq_mask(s + i, l, u);
+				if (m) return i + lowest_bit(m) / sizeof(T);
+			}
+#endif
+			for (; i < n; i++)
+				if (s[i] == lower || s[i] == up) return i;
+			return n;
 		}
-#ifdef STR_USE_BINDINGS
+
 		/*
-		*** string_base<T>(const string_base<T> &, unsigned, unsigned)
-		*** constructor to assign substring of an std::basic_string sequence
-		(starting at position "start2 with a length of "count")
-		*** automatically inserts null-terminator at the end
-		*** if "start" is greater than str's length, then start = 0
-		*** Added with Version 1.4
+		*** char comparison policies of the Two-Way functions below: exact 
+		values, or ASCII letters without case (see fold())
 		*/
-		explicit string_base<T>(const std_string &str, unsigned start, unsigned count) {
-			unsigned l = str.length();
-			if (start > l) start = 0;
-			if ((start + count) > l)
-				count = (l - start);
-			len = count; cap = len + 1;
-			raw_data = new T[cap];
-			memcpy(raw_data, str.c_str() + start, count * sizeof(T));
-			raw_data[len] = 0x00;
+		struct exact_chars {
+			template <typename T> static T key(T c) { return c; }
+			template <typename T> static bool equal(const T *a, const T *b, unsigned n) { return !memcmp(a, b, n * sizeof(T)); }
+		};
+		struct ascii_fold {
+			template <typename T> static T key(T c) { return fold(c); }
+			template <typename T> static bool equal(const T *a, const T *b, unsigned n) { return imismatch(a, b, n) == n; }
+		};
+
+		/* returns the number of set bits in "x" */
+		inline unsigned popcount(unsigned x) {
+			x = x - ((x >> 1) & 0x55555555U);
+			x = (x & 0x33333333U) + ((x >> 2) & 0x33333333U);
+			return (((x + (x >> 4)) & 0x0F0F0F0FU) * 0x01010101U) >> 24;
 		}
-#endif
+#ifdef STR_SSSE3
 		/*
-		*** string_base<T>(const T*, unsigned, unsigned)
-		*** constructor to assign substring of a C-String 
-		(starting at position "start2 with a length of "count")
-		*** allocate enough space ("count" + 1)
-		*** automatically inserts null-terminator at the end
-		*** if "start" is greater than str's length, then start = 0
-		*** Version 1.2: Optimizing, using memcpy() now
-		*** Version 1.2: fix crash when "start" is greater than str's length
+		*** const unsigned long long *compress_table(void)
+		*** pshufb control words moving the bytes selected by an 8 bit mask to 
+		the front of 8 bytes (entry "k" keeps byte "i" if bit "i" of "k" is set)
 		*/
-		explicit string_base<T>(const T *c_str, unsigned start, unsigned count) {
-			unsigned l = strlength<T>(c_str);
-			if (start > l) start = 0;
-			if ((start + count) > l) 
-				count = (l - start);
-			len = count; cap = len + 1;
-			raw_data = new T[cap];
-			memcpy(raw_data, c_str + start, count * sizeof(T));
-			raw_data[len] = 0x00;
+		inline const unsigned long long *compress_table() {
+			static const unsigned long long table[256] = {
+			0x8080808080808080ULL, 0x8080808080808000ULL, 0x8080808080808001ULL, 0x8080808080800100ULL,
+			0x8080808080808002ULL, 0x8080808080800200ULL, 0x8080808080800201ULL, 0x8080808080020100ULL,
+			0x8080808080808003ULL, 0x8080808080800300ULL, 0x8080808080800301ULL, 0x8080808080030100ULL,
+			0x8080808080800302ULL, 0x8080808080030200ULL, 0x8080808080030201ULL, 0x8080808003020100ULL,
+			0x8080808080808004ULL, 0x8080808080800400ULL, 0x8080808080800401ULL, 0x8080808080040100ULL,
+			0x8080808080800402ULL, 0x8080808080040200ULL, 0x8080808080040201ULL, 0x8080808004020100ULL,
+			0x8080808080800403ULL, 0x8080808080040300ULL, 0x8080808080040301ULL, 0x8080808004030100ULL,
+			0x8080808080040302ULL, 0x8080808004030200ULL, 0x8080808004030201ULL, 0x8080800403020100ULL,
+			0x8080808080808005ULL, 0x8080808080800500ULL, 0x8080808080800501ULL, 0x8080808080050100ULL,
+			0x8080808080800502ULL, 0x8080808080050200ULL, 0x8080808080050201ULL, 0x8080808005020100ULL,
+			0x8080808080800503ULL, 0x8080808080050300ULL, 0x8080808080050301ULL, 0x8080808005030100ULL,
+			0x8080808080050302ULL, 0x8080808005030200ULL, 0x8080808005030201ULL, 0x8080800503020100ULL,
+			0x8080808080800504ULL, 0x8080808080050400ULL, 0x8080808080050401ULL, 0x8080808005040100ULL,
+			0x8080808080050402ULL, 0x8080808005040200ULL, 0x8080808005040201ULL, 0x8080800504020100ULL,
+			0x8080808080050403ULL, 0x8080808005040300ULL, 0x8080808005040301ULL, 0x8080800504030100ULL,
+			0x8080808005040302ULL, 0x8080800504030200ULL, 0x8080800504030201ULL, 0x8080050403020100ULL,
+			0x8080808080808006ULL, 0x8080808080800600ULL, 0x8080808080800601ULL, 0x8080808080060100ULL,
+			0x8080808080800602ULL, 0x8080808080060200ULL, 0x8080808080060201ULL, 0x8080808006020100ULL,
+			0x8080808080800603ULL, 0x8080808080060300ULL, 0x8080808080060301ULL, 0x8080808006030100ULL,
+			0x8080808080060302ULL, 0x8080808006030200ULL, 0x8080808006030201ULL, 0x8080800603020100ULL,
+			0x8080808080800604ULL, 0x8080808080060400ULL, 0x8080808080060401ULL, 0x8080808006040100ULL,
+			0x8080808080060402ULL, 0x8080808006040200ULL, 0x8080808006040201ULL, 0x8080800604020100ULL,
+			0x8080808080060403ULL, 0x8080808006040300ULL, 0x8080808006040301ULL, 0x8080800604030100ULL,
+			0x8080808006040302ULL, 0x8080800604030200ULL, 0x8080800604030201ULL, 0x8080060403020100ULL,
+			0x8080808080800605ULL, 0x8080808080060500ULL, 0x8080808080060501ULL, 0x8080808006050100ULL,
+			0x8080808080060502ULL, 0x8080808006050200ULL, 0x8080808006050201ULL, 0x8080800605020100ULL,
+			0x8080808080060503ULL, 0x8080808006050300ULL, 0x8080808006050301ULL, 0x8080800605030100ULL,
+			0x8080808006050302ULL, 0x8080800605030200ULL, 0x8080800605030201ULL, 0x8080060503020100ULL,
+			0x8080808080060504ULL, 0x8080808006050400ULL, 0x8080808006050401ULL, 0x8080800605040100ULL,
+			0x8080808006050402ULL, 0x8080800605040200ULL, 0x8080800605040201ULL, 0x8080060504020100ULL,
+			0x8080808006050403ULL, 0x8080800605040300ULL, 0x8080800605040301ULL, 0x8080060504030100ULL,
+			0x8080800605040302ULL, 0x8080060504030200ULL, 0x8080060504030201ULL, 0x8006050403020100ULL,
+			0x8080808080808007ULL, 0x8080808080800700ULL, 0x8080808080800701ULL, 0x8080808080070100ULL,
+			0x8080808080800702ULL, 0x8080808080070200ULL, 0x8080808080070201ULL, 0x8080808007020100ULL,
+			0x8080808080800703ULL, 0x8080808080070300ULL, 0x8080808080070301ULL, 0x8080808007030100ULL,
+			0x8080808080070302ULL, 0x8080808007030200ULL, 0x8080808007030201ULL, 0x8080800703020100ULL,
+			0x8080808080800704ULL, 0x8080808080070400ULL, 0x8080808080070401ULL, 0x8080808007040100ULL,
+			0x8080808080070402ULL, 0x8080808007040200ULL, 0x8080808007040201ULL, 0x8080800704020100ULL,
+			0x8080808080070403ULL, 0x8080808007040300ULL, 0x8080808007040301ULL, 0x8080800704030100ULL,
+			0x8080808007040302ULL, 0x8080800704030200ULL, 0x8080800704030201ULL, 0x8080070403020100ULL,
+			0x8080808080800705ULL, 0x8080808080070500ULL, 0x8080808080070501ULL, 0x8080808007050100ULL,
+			0x8080808080070502ULL, 0x8080808007050200ULL, 0x8080808007050201ULL, 0x8080800705020100ULL,
+			0x8080808080070503ULL, 0x8080808007050300ULL, 0x8080808007050301ULL, 0x8080800705030100ULL,
+			0x8080808007050302ULL, 0x8080800705030200ULL, 0x8080800705030201ULL, 0x8080070503020100ULL,
+			0x8080808080070504ULL, 0x8080808007050400ULL, 0x8080808007050401ULL, 0x8080800705040100ULL,
+			0x8080808007050402ULL, 0x8080800705040200ULL, 0x8080800705040201ULL, 0x8080070504020100ULL,
+			0x8080808007050403ULL, 0x8080800705040300ULL, 0x8080800705040301ULL, 0x8080070504030100ULL,
+			0x8080800705040302ULL, 0x8080070504030200ULL, 0x8080070504030201ULL, 0x8007050403020100ULL,
+			0x8080808080800706ULL, 0x8080808080070600ULL, 0x8080808080070601ULL, 0x8080808007060100ULL,
+			0x8080808080070602ULL, 0x8080808007060200ULL, 0x8080808007060201ULL, 0x8080800706020100ULL,
+			0x8080808080070603ULL, 0x8080808007060300ULL, 0x8080808007060301ULL, 0x8080800706030100ULL,
+			0x8080808007060302ULL, 0x8080800706030200ULL, 0x8080800706030201ULL, 0x8080070603020100ULL,
+			0x8080808080070604ULL, 0x8080808007060400ULL, 0x8080808007060401ULL, 0x8080800706040100ULL,
+			0x8080808007060402ULL, 0x8080800706040200ULL, 0x8080800706040201ULL, 0x8080070604020100ULL,
+			0x8080808007060403ULL, 0x8080800706040300ULL, 0x8080800706040301ULL, 0x8080070604030100ULL,
+			0x8080800706040302ULL, 0x8080070604030200ULL, 0x8080070604030201ULL, 0x8007060403020100ULL,
+			0x8080808080070605ULL, 0x8080808007060500ULL, 0x8080808007060501ULL, 0x8080800706050100ULL,
+			0x8080808007060502ULL, 0x8080800706050200ULL, 0x8080800706050201ULL, 0x8080070605020100ULL,
+			0x8080808007060503ULL, 0x8080800706050300ULL, 0x8080800706050301ULL, 0x8080070605030100ULL,
+			0x8080800706050302ULL, 0x8080070605030200ULL, 0x8080070605030201ULL, 0x8007060503020100ULL,
+			0x8080808007060504ULL, 0x8080800706050400ULL, 0x8080800706050401ULL, 0x8080070605040100ULL,
+			0x8080800706050402ULL, 0x8080070605040200ULL, 0x8080070605040201ULL, 0x8007060504020100ULL,
+			0x8080800706050403ULL, 0x8080070605040300ULL, 0x8080070605040301ULL, 0x8007060504030100ULL,
+			0x8080070605040302ULL, 0x8007060504030200ULL, 0x8007060504030201ULL, 0x0706050403020100ULL
+			};
+			return table;
 		}
+#endif
 		/*
-		*** ~string_base<T>()
-		*** default destructor to deallocate used memory 
-		*** You might consider using cleanup() instead 
-		(define DEF_USE_CLEANUP_FUNCTION to make it available)
-		*** Readded with Version 1.4
+		*** unsigned remove_char(T *, unsigned, T)
+		*** removes every "ch" from the first "n" chars of "s" (stream compaction)
+		*** 1-byte chars are compacted with pshufb (SSSE3), 16 at a time, 
+		others by moving the runs between two "ch" found by find_char()
+		*** returns the new length
 		*/
-		~string_base<T>() {
-			delete[] raw_data;
-#ifdef STR_CPP11_OR_HIGHER
-			/* nullptr is a typesafe alternative to NULL */
-			raw_data = nullptr;
-#else
-			/* C++98 support by avoiding nullptr */
-			raw_data = NULL;
+		template <typename T>
+		unsigned remove_char(T *s, unsigned n, T ch) {
+			unsigned i = find_char(s, n, ch), w = i;
+#ifdef STR_SSSE3
+			if (sizeof(T) == 1) {
+				const unsigned long long *table = compress_table();
+				const __m128i v = splat((unsigned)ch, width<1>());
+				const __m128i eight = _mm_set1_epi8(8);
+				unsigned char *b = (unsigned char *)s;
+				for (; i + 16 <= n; i += 16) {
+					__m128i x = _mm_loadu_si128((const __m128i *)(b + i));
+					unsigned keep = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, v)) & 0xFFFF;
+					if (keep == 0xFFFF) {
+						_mm_storeu_si128((__m128i *)(b + w), x);
+						w += 16;
+						continue;
+					}
+					__m128i lo = _mm_loadl_epi64((const __m128i *)(table + (keep & 0xFF)));
+					__m128i hi = _mm_add_epi8(_mm_loadl_epi64((const __m128i *)(table + (keep >> 8))), eight);
+					x = _mm_shuffle_epi8(x, _mm_unpacklo_epi64(lo, hi));
+					/* both stores stay within the 16 bytes which have just been read */
+					_mm_storel_epi64((__m128i *)(b + w), x);
+					w += popcount(keep & 0xFF);
+					_mm_storel_epi64((__m128i *)(b + w), _mm_unpackhi_epi64(x, x));
+					w += popcount(keep >> 8);
+				}
+				for (; i < n; ++i)
+					if (s[i] != ch) s[w++] = s[i];
+				return w;
+			}
 #endif
+			while (i < n) {
+				++i;
+				unsigned r = find_char(s + i, n - i, ch);
+				memmove(s + w, s + i, r * sizeof(T));
+				w += r;
+				i += r;
+			}
+			return w;
 		}
 
-		T *data() const { return raw_data; } /* returns C-String value */
-		const T *c_str() const { return (const T *)raw_data; } /* returns C-String (const) value */
-		const unsigned length() const { return len; } /* returns length of current string instance */
-		const unsigned size() const { return len * sizeof(T); } /* returns current size in bytes the actual string with its chars uses */
-		const unsigned capacity() const { return cap; } /* returns maximum number of chars this value can hold in currently allocated state */
+		/* needles of at least this many 1-byte chars are searched with a shift table */
+		enum { long_needle = 32 };
+
 		/*
-		*** T &at(unsigned) 
-		*** returns reference to a character at position "pos"
-		*** if "pos" is out of range, it returns the last char of string (len - 1)
-		*** Version 1.2: Optimizing, remove "ac_len" variable
+		*** unsigned critical_factorization(const T *, unsigned, unsigned &)
+		*** computes a critical factorization of the needle for the Two-Way algorithm
+		*** returns the start of its right half and stores the period of that half in "period"
+		*** based on the Two-Way implementation of glibc (Crochemore and Perrin, 1991)
+		*** chars are compared by K::key() (exact_chars or ascii_fold), the same 
+		holds for the other Two-Way functions
 		*/
-		reference at(unsigned pos) { return raw_data[(pos > (len - 1) ? (len - 1) : pos)]; }
+		template <typename K, typename T>
+		unsigned critical_factorization(const T *nd, unsigned m, unsigned &period) {
+			unsigned max_suffix, max_suffix_rev, j, k, p;
+			/* maximal suffix for "<" */
+			max_suffix = (unsigned)-1; j = 0; k = p = 1;
+			while (j + k < m) {
+				T a = K::key(nd[j + k]), b = K::key(nd[max_suffix + k]);
+				if (a < b) { j += k; k = 1; p = j - max_suffix; }
+				else if (a == b) { if (k != p) ++k; else { j += p; k = 1; } }
+				else { max_suffix = j++; k = p = 1; }
+			}
+			period = p;
+			/* maximal suffix for ">" */
+			max_suffix_rev = (unsigned)-1; j = 0; k = p = 1;
+			while (j + k < m) {
+				T a = K::key(nd[j + k]), b = K::key(nd[max_suffix_rev + k]);
+				if (b < a) { j += k; k = 1; p = j - max_suffix_rev; }
+				else if (a == b) { if (k != p) ++k; else { j += p; k = 1; } }
+				else { max_suffix_rev = j++; k = p = 1; }
+			}
+			if (max_suffix_rev + 1 < max_suffix + 1)
+				return max_suffix + 1;
+			period = p;
+			return max_suffix_rev + 1;
+		}
 		/*
-		*** const T &at(unsigned) const
-		*** returns reference to a character at position "pos"
-		*** if "pos" is out of range, it returns the last char of string (len - 1)
-		*** if current string value is const-qualified, it returns this function when 
-		"at" is called outside of the class
-		*** Version 1.2: Optimizing, remove "ac_len" variable
+		*** void two_way_prepare(const T *, unsigned, unsigned &, unsigned &, bool &)
+		*** preprocessing of the Two-Way algorithm (see two_way_search())
+		*** stores start of the right half in "suffix", the shift after a mismatch 
+		in the left half in "period" and whether the needle is periodic in "periodic"
 		*/
-		const_reference at(unsigned pos) const { return raw_data[(pos > (len - 1) ? (len - 1) : pos)]; }
+		template <typename K, typename T>
+		void two_way_prepare(const T *nd, unsigned m, unsigned &suffix, unsigned &period, bool &periodic) {
+			suffix = critical_factorization<K>(nd, m, period);
+			periodic = K::equal(nd, nd + period, suffix);
+			if (!periodic) period = MAX(suffix, m - suffix) + 1;
+		}
 		/*
-		*** bool at(const T, unsigned)
-		*** checks if given character "ch" is at given position "pos"
-		*** if "pos" is out of range, it compares last char of string (len - 1)
-		*** returns true, if char's value is at position "pos", false if not
-		*** Version 1.2: Optimizing, remove "ac_len" variable
-		*/
-		bool at(const T ch, unsigned pos) { return (raw_data[(pos > (len - 1) ? (len - 1) : pos)] == ch); }
-		/* 
-		*** T &first()
-		*** returns reference to first char of string 
-		*** can be also used to change value of first char
+		*** unsigned two_way_search(const T *, unsigned, const T *, unsigned, unsigned, unsigned, bool)
+		*** Two-Way string matching, returns index of the first match or "n"
+		*** takes the results of two_way_prepare() for needle "nd"
+		*** linear worst case (at most 2 * n comparisons), constant extra memory
+		*** "m" has to be within [1, n]
 		*/
-		reference first() { return raw_data[0]; }
+		template <typename K, typename T>
+		unsigned two_way_search(const T *h, unsigned n, const T *nd, unsigned m, unsigned suffix, unsigned period, bool periodic) {
+			unsigned i, j = 0;
+			if (periodic) {
+				/* periodic needle, remember how much of it is known to match after a shift */
+				unsigned memory = 0;
+				while (j <= n - m) {
+					i = MAX(suffix, memory);
+					while (i < m && K::key(nd[i]) == K::key(h[i + j])) ++i;
+					if (i >= m) {
+						i = suffix - 1;
+						while (memory < i + 1 && K::key(nd[i]) == K::key(h[i + j])) --i;
+						if (i + 1 < memory + 1) return j;
+						j += period;
+						memory = m - period;
+					}
+					else { j += i - suffix + 1; memory = 0; }
+				}
+			}
+			else {
+				while (j <= n - m) {
+					i = suffix;
+					while (i < m && K::key(nd[i]) == K::key(h[i + j])) ++i;
+					if (i >= m) {
+						i = suffix - 1;
+						while (i != (unsigned)-1 && K::key(nd[i]) == K::key(h[i + j])) --i;
+						if (i == (unsigned)-1) return j;
+						j += period;
+					}
+					else j += i - suffix + 1;
+				}
+			}
+			return n;
+		}
+		/* Two-Way string matching without preprocessed needle (see two_way_search()) */
+		template <typename K, typename T>
+		unsigned two_way(const T *h, unsigned n, const T *nd, unsigned m) {
+			unsigned suffix, period;
+			bool periodic;
+			two_way_prepare<K>(nd, m, suffix, period, periodic);
+			return two_way_search<K>(h, n, nd, m, suffix, period, periodic);
+		}
 		/*
-		*** const T &first() const
-		*** returns reference to first char of string
-		*** if current string value is const-qualified, 
-		it returns this function when "first" is called 
-		outside of the class
+		*** unsigned two_way_long(const T *, unsigned, const T *, unsigned, width<1>)
+		*** Two-Way string matching with a Boyer-Moore-Horspool shift table on 
+		the last char of the window, for long needles of 1-byte chars
+		*** skips up to "m" chars at once (sublinear on average), still linear in the worst case
+		*** "m" has to be within [1, n]
 		*/
-		const_reference first() const { return raw_data[0]; }
-		/* 
-		*** T &last()
-		*** returns reference to last char of string 
-		*** can be also used to change value of last char
+		template <typename K, typename T>
+		unsigned two_way_long(const T *h, unsigned n, const T *nd, unsigned m, width<1>) {
+			unsigned shift_table[256], period, i, j = 0, shift;
+			unsigned suffix = critical_factorization<K>(nd, m, period);
+			for (i = 0; i < 256; i++) shift_table[i] = m;
+			for (i = 0; i < m; i++) shift_table[(unsigned char)K::key(nd[i])] = m - i - 1;
+			if (K::equal(nd, nd + period, suffix)) {
+				unsigned memory = 0;
+				while (j <= n - m) {
+					shift = shift_table[(unsigned char)K::key(h[j + m - 1])];
+					if (shift) {
+						/* the last period has a char out of place, no match before the mismatch */
+						if (memory && shift < period) shift = m - period;
+						memory = 0;
+						j += shift;
+						continue;
+					}
+					i = MAX(suffix, memory);
+					while (i < m - 1 && K::key(nd[i]) == K::key(h[i + j])) ++i;
+					if (i >= m - 1) {
+						i = suffix - 1;
+						while (memory < i + 1 && K::key(nd[i]) == K::key(h[i + j])) --i;
+						if (i + 1 < memory + 1) return j;
+						j += period;
+						memory = m - period;
+					}
+					else { j += i - suffix + 1; memory = 0; }
+				}
+			}
+			else {
+				period = MAX(suffix, m - suffix) + 1;
+				while (j <= n - m) {
+					shift = shift_table[(unsigned char)K::key(h[j + m - 1])];
+					if (shift) { j += shift; continue; }
+					i = suffix;
+					while (i < m - 1 && K::key(nd[i]) == K::key(h[i + j])) ++i;
+					if (i >= m - 1) {
+						i = suffix - 1;
+						while (i != (unsigned)-1 && K::key(nd[i]) == K::key(h[i + j])) --i;
+						if (i == (unsigned)-1) return j;
+						j += period;
+					}
+					else j += i - suffix + 1;
+				}
+			}
+			return n;
+		}
+		/* wider chars would need a hashed table (and lose exact shifts), use plain Two-Way */
+		template <typename K, typename T, unsigned N>
+		unsigned two_way_long(const T *h, unsigned n, const T *nd, unsigned m, width<N>) { return two_way<K>(h, n, nd, m); }
+
+#ifdef STR_SSE2
+		/*
+		*** unsigned pair_filter(const T *, unsigned, const T *, unsigned, unsigned, unsigned, __m128i, __m128i, unsigned &)
+		*** SIMD filter for needle "nd" (length "m" >= 2): compares the haystack with 
+		the needle's chars at positions "i1" and "i2" (broadcast in "v1" and "v2")
+		for 16 bytes of window positions at once, candidates are verified with memcmp()
+		*** returns index of the first match, or "n"
+		*** stops at the end of the vectorizable range or once verification work exceeds 
+		a constant factor of the scanned chars, "stop" is set to the first window 
+		position which has not been checked then ("n" if done)
 		*/
-		reference last() {
-			if (!len) return raw_data[0];
-			return raw_data[len - 1];
+		template <typename T>
+		unsigned pair_filter(const T *h, unsigned n, const T *nd, unsigned m, unsigned i1, unsigned i2, __m128i v1, __m128i v2, unsigned &stop) {
+			const unsigned step = 16 / sizeof(T);
+			unsigned i = 0, work = 0;
+			for (; i + step + m - 1 <= n; i += step) {
+				unsigned mask = eq_mask(h + i + i1, v1) & eq_mask(h + i + i2, v2);
+				while (mask) {
+					unsigned k = lowest_bit(mask) / sizeof(T);
+					if (!memcmp(h + i + k, nd, m * sizeof(T)))
+						return i + k;
+					mask &= ~(((1U << sizeof(T)) - 1) << (k * sizeof(T)));
+					work += m;
+				}
+				if (work > 4 * i + 256) { i += step; break; } /* too many false positives */
+			}
+			stop = (i + m > n) ? n : i;
+			return n;
 		}
+#endif
 		/*
-		*** const T &last() const
-		*** returns reference to last char of string
-		*** if current string value is const-qualified,
-		it returns this function when "last" is called
-		outside of the class
+		*** unsigned horspool(const T *, unsigned, const T *, unsigned, const unsigned char *, unsigned &)
+		*** Boyer-Moore-Horspool search with a 256 entry skip table (indexed by the 
+		low byte of the last char of the window, capped to 255 chars)
+		*** returns index of the first match, or "n"
+		*** gives up once verification work exceeds a constant factor of the 
+		scanned chars, "stop" is set to the first window position which has not 
+		been checked then ("n" if done)
 		*/
-		const_reference last() const {
-			if (!len) return raw_data[0];
-			return raw_data[len - 1];
+		template <typename T>
+		unsigned horspool(const T *h, unsigned n, const T *nd, unsigned m, const unsigned char *skip, unsigned &stop) {
+			unsigned j = 0, work = 0;
+			const T last = nd[m - 1];
+			while (j <= n - m) {
+				T c = h[j + m - 1];
+				if (c == last) {
+					if (!memcmp(h + j, nd, (m - 1) * sizeof(T))) return j;
+					work += m;
+					if (work > 4 * j + 256) { stop = j + 1; return n; }
+				}
+				j += skip[(unsigned)c & 0xFF];
+			}
+			stop = n;
+			return n;
 		}
-		bool empty() const { return (len == 0); } /* checks whether string is empty */
-		iterator begin() const { return &raw_data[0]; } /* returns iterator to the beginning of string */
-		iterator end() const { return &raw_data[len]; } /* returns iterator to the ending of string */
-		const_iterator cbegin() const { return &raw_data[0]; } /* returns constant iterator to the beginning of string */
-		const_iterator cend() const { return &raw_data[len]; } /* returns constant iterator to the ending of string */
 
+#ifdef STR_SSSE3
 		/*
-		*** unsigned copy(T *, unsigned, unsigned = 0U)
-		*** copy "size" chars of current string object starting from 
-		position "size" to position "pos" in "buffer"
-		*** doesn't modify current string value
-		*** returns number of chars copied
-		*** does nothing if 
-			-> buffer is NULL
-			-> current string data is NULL
-			-> size == 0
-		*** if buffer is too small, behavior is undefined
-		*** Added with Version 1.7
+		*** unsigned teddy(const unsigned char *, unsigned, const unsigned char *, const unsigned char *, unsigned)
+		*** Teddy prefilter for sets of byte strings (as in Hyperscan): each pattern 
+		is assigned to one of 8 buckets, "lo" and "hi" hold for each of the first 
+		"k" pattern positions (16 entries each) the buckets whose patterns have a 
+		char with that low / high nibble there
+		*** returns the first position at which a pattern may start (it is a 
+		superset of the real starts, every pattern has to be at least "k" long), or "n"
 		*/
-		unsigned copy(T *buffer, unsigned size, unsigned pos = 0U) {
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
-			assert(buffer != NULL);
-#else 
-			if (!buffer || !raw_data || !size)
-				return 0;
-#endif
-			if (pos > len) pos = 0;
-			if ((pos + size) > len) size = (len - pos);
-			memcpy(buffer, raw_data + pos, size * sizeof(T));
-			buffer[size] = 0x00;
-			return size;
+		inline unsigned teddy(const unsigned char *h, unsigned n, const unsigned char *lo, const unsigned char *hi, unsigned k) {
+			const __m128i nibble = _mm_set1_epi8(0x0F);
+			unsigned i = 0, j;
+			for (; i + 16 + k - 1 <= n; i += 16) {
+				__m128i m = _mm_set1_epi8((char)0xFF);
+				for (j = 0; j < k; ++j) {
+					__m128i b = _mm_loadu_si128((const __m128i *)(h + i + j));
+					__m128i l = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(lo + 16 * j)), _mm_and_si128(b, nibble));
+					__m128i u = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(hi + 16 * j)), _mm_and_si128(_mm_srli_epi16(b, 4), nibble));
+					m = _mm_and_si128(m, _mm_and_si128(l, u));
+				}
+				unsigned mask = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(m, _mm_setzero_si128())) & 0xFFFF;
+				if (mask) return i + lowest_bit(mask);
+			}
+			for (; i + k <= n; ++i) {
+				unsigned m = 0xFF;
+				for (j = 0; j < k; ++j) m &= lo[16 * j + (h[i + j] & 0x0F)] & hi[16 * j + (h[i + j] >> 4)];
+				if (m) return i;
+			}
+			return n;
 		}
-
 		/*
-		*** string_base<T> &splice(string_base<T> &, unsigned, unsigned, unsigned)
-		*** transfer substring of current string value (starting on position "start" 
-		with a length of "size") and insert it in "buffer" at position "pos"
-		*** transfer means, it deletes the substring portion from current string value
-		*** does nothing if
-			-> current string data == NULL
-			-> size == 0
-			-> current string equals to buffer
-		*** returns (eventually) modified string object
-		*** Added with Version 1.7
+		*** unsigned set_mask(const unsigned char *, __m128i, __m128i)
+		*** byte mask of the 16 bytes at "p" that belong to a set of bytes: bit "h" 
+		of lo[l] (hi[l]) is set if byte 16 * h + l (16 * (h + 8) + l) is in the set, 
+		the low nibble selects the row, the high nibble the bit (exact for all 256 bytes)
 		*/
-		string_base<T> &splice(string_base<T> &buffer, unsigned start, unsigned size, unsigned pos) {
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
-			assert(this != &buffer);
-#else 
-			if (!raw_data || !size || this == &buffer) return (*this);
+		inline unsigned set_mask(const unsigned char *p, __m128i lo, __m128i hi) {
+			const __m128i nibble = _mm_set1_epi8(0x0F);
+			__m128i b = _mm_loadu_si128((const __m128i *)p);
+			__m128i l = _mm_and_si128(b, nibble), h = _mm_and_si128(_mm_srli_epi16(b, 4), nibble);
+			__m128i upper = _mm_cmpgt_epi8(h, _mm_set1_epi8(7));
+			__m128i row = _mm_or_si128(_mm_andnot_si128(upper, _mm_shuffle_epi8(lo, l)), _mm_and_si128(upper, _mm_shuffle_epi8(hi, l)));
+			__m128i bit = _mm_shuffle_epi8(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128), h);
+			return ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(row, bit), _mm_setzero_si128())) & 0xFFFF;
+		}
 #endif
-			if (start > len) start = 0;
-			if (pos > buffer.len) pos = 0;
-			if ((pos + size) > len) size = (len - pos);
-			buffer.insert(*this, pos, start, size);
-			erase(start, size);
-			return (*this);
+#ifdef STR_SSE2
+		/*
+		*** unsigned find_any(const T *, unsigned, const T *, unsigned)
+		*** returns index of the first char of "h" that is one of the "m" (1 - 3) chars in "set", or "n"
+		*/
+		template <typename T>
+		unsigned find_any(const T *h, unsigned n, const T *set, unsigned m) {
+			const unsigned step = 16 / sizeof(T);
+			const __m128i a = splat((unsigned)set[0], width<sizeof(T)>());
+			const __m128i b = splat((unsigned)set[m > 1 ? 1 : 0], width<sizeof(T)>());
+			const __m128i c = splat((unsigned)set[m > 2 ? 2 : 0], width<sizeof(T)>());
+			unsigned i = 0;
+			for (; i + step <= n; i += step) {
+				__m128i v = _mm_loadu_si128((const __m128i *)(h + i));
+				__m128i e = _mm_or_si128(_mm_or_si128(cmpeq(v, a, width<sizeof(T)>()), cmpeq(v, b, width<sizeof(T)>())), cmpeq(v, c, width<sizeof(T)>()));
+				unsigned mask = (unsigned)_mm_movemask_epi8(e);
+				if (mask) return i + lowest_bit(mask) / sizeof(T);
+			}
+			for (; i < n; ++i)
+				if (h[i] == set[0] || h[i] == set[m > 1 ? 1 : 0] || h[i] == set[m > 2 ? 2 : 0]) return i;
+			return n;
 		}
+#endif
 
 		/*
-		*** string_base<T> &fill(const T &)
-		*** fill whole string buffer with T's value
-		*** inserts null-terminator at the end
-		*** Does nothing if
-			-> len == 0 (string is empty)
-			-> raw_data == NULL (allocation error)
-		*** returns (eventually modified) *this object
-		*** Added with Version 1.5
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*** unsigned find_str(const T *, unsigned, const T *, unsigned)
+		*** returns index of the first occurrence of needle "nd" (length "m") within 
+		the first "n" chars of "h", "n" if it has not been found (0 for empty needles)
+		*** picks a strategy by needle length and char width:
+			-> 1 char:						find_char()
+			-> long needles (1-byte chars):	Two-Way with shift table
+			-> otherwise:					SIMD filter on the first and last char of the needle, 
+											candidates are verified with memcmp()
+		*** the SIMD filter counts its verification work and hands over to Two-Way 
+		once it exceeds a constant factor of the scanned chars, so adversarial 
+		inputs still run in linear time
 		*/
-		string_base<T> &fill(const T &ch) {
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
+		template <typename T>
+		unsigned find_str(const T *h, unsigned n, const T *nd, unsigned m) {
+			if (!m) return 0;
+			if (m > n) return n;
+			if (m == 1) return find_char(h, n, nd[0]);
+			if (sizeof(T) == 1 && m >= (unsigned)long_needle)
+				return two_way_long<exact_chars>(h, n, nd, m, width<sizeof(T)>());
+			unsigned i = 0;
+#ifdef STR_SSE2
+			unsigned f = pair_filter(h, n, nd, m, 0, m - 1, 
+				splat((unsigned)nd[0], width<sizeof(T)>()), splat((unsigned)nd[m - 1], width<sizeof(T)>()), i);
+			if (f != n) return f;
 #endif
-			if (!len) return (*this);
-			for (unsigned i = 0; i < len; i++)
-				raw_data[i] = ch;
-			raw_data[len] = 0x00;
-			return (*this);
+			if (m > n - i) return n;
+			unsigned r = two_way<exact_chars>(h + i, n - i, nd, m);
+			return (r == n - i) ? n : (i + r);
 		}
+
+#ifdef STR_SSE2
 		/*
-		*** string_base<T> &fill(const T &)
-		*** fill first "count" places in 
-		string buffer with T's value
-		*** inserts null-terminator at the end
-		*** Does nothing if
-			-> len == 0 (string is empty)
-			-> raw_data == NULL (allocation error)
-			-> count == 0 (no chars to copy)
-		*** returns (eventually modified) *this object
-		*** Added with Version 1.5
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*** unsigned ipair_filter(const T *, unsigned, const T *, unsigned, unsigned &)
+		*** pair_filter() without case: compares the haystack with both cases of 
+		the needle's first and last char, candidates are verified with imismatch()
+		*** same work limit and "stop" as pair_filter()
 		*/
-		string_base<T> &fill(const T &ch, unsigned count) {
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
-#endif
-			if (!len || !count) return (*this);
-			unsigned ac_len = MIN(count, len);
-			for (unsigned i = 0; i < ac_len; i++)
-				raw_data[i] = ch;
-			raw_data[len] = 0x00;
-			return (*this);
+		template <typename T>
+		unsigned ipair_filter(const T *h, unsigned n, const T *nd, unsigned m, unsigned &stop) {
+			const unsigned step = 16 / sizeof(T);
+			const __m128i fl = splat((unsigned)fold(nd[0]), width<sizeof(T)>()), fu = splat((unsigned)upper(nd[0]), width<sizeof(T)>());
+			const __m128i ll = splat((unsigned)fold(nd[m - 1]), width<sizeof(T)>()), lu = splat((unsigned)upper(nd[m - 1]), width<sizeof(T)>());
+			unsigned i = 0, work = 0;
+			for (; i + step + m - 1 <= n; i += step) {
+				unsigned mask = ieq_mask(h + i, fl, fu) & ieq_mask(h + i + m - 1, ll, lu);
+				while (mask) {
+					unsigned k = lowest_bit(mask) / sizeof(T);
+					if (imismatch(h + i + k + 1, nd + 1, m - 2) == m - 2)
+						return i + k;
+					mask &= ~(((1U << sizeof(T)) - 1) << (k * sizeof(T)));
+					work += m;
+				}
+				if (work > 4 * i + 256) { i += step; break; } /* too many false positives */
+			}
+			stop = (i + m > n) ? n : i;
+			return n;
 		}
+#endif
 		/*
-		*** string_base<T> &fill(const T &)
-		*** fill substring of string buffer with T's value
-		*** inserts null-terminator at the end
-		*** Does nothing if
-			-> len == 0 (string is empty)
-			-> raw_data == NULL (allocation error)
-			-> count == 0 (no chars to copy)
-		*** If start is greater than current string length, then start = 0
-		*** returns (eventually modified) *this object
-		*** Added with Version 1.5
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*** unsigned ifind_str(const T *, unsigned, const T *, unsigned)
+		*** like find_str(), but ASCII letters are compared without case (see fold())
+		*** same strategies, all of them fold while comparing (no copy of needle 
+		or haystack): ifind_char() for single chars, Two-Way with a folded shift 
+		table for long needles, otherwise the SIMD filter on both cases of the 
+		needle's first and last char with Two-Way as linear time fallback
 		*/
-		string_base<T> &fill(const T &ch, unsigned start, unsigned count) {
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
+		template <typename T>
+		unsigned ifind_str(const T *h, unsigned n, const T *nd, unsigned m) {
+			if (!m) return 0;
+			if (m > n) return n;
+			if (m == 1) return ifind_char(h, n, nd[0]);
+			if (sizeof(T) == 1 && m >= (unsigned)long_needle)
+				return two_way_long<ascii_fold>(h, n, nd, m, width<sizeof(T)>());
+			unsigned i = 0;
+#ifdef STR_SSE2
+			unsigned f = ipair_filter(h, n, nd, m, i);
+			if (f != n) return f;
 #endif
-			if (!len || !count) return (*this);
-			if (start > len) start = 0;
-			if ((start + count) > len) count = (len - start);
-			for (unsigned i = start; i < (start + count); i++)
-				raw_data[i] = ch;
-			raw_data[len] = 0x00;
-			return (*this);
+			if (m > n - i) return n;
+			unsigned r = two_way<ascii_fold>(h + i, n - i, nd, m);
+			return (r == n - i) ? n : (i + r);
 		}
+	} /* namespace "simd" */
+
+	/*
+	*********************************************************************
+	*** hash functions												  ***
+	*********************************************************************
+	*** wyhash (final version 4, by Wang Yi, public domain): 64 bit, 
+	non-cryptographic, passes SMHasher
+	*** inputs longer than 48 bytes are hashed in three independent lanes 
+	of 16 bytes each, so the multiplications of one round run in parallel
+	*** reads are little endian, results depend on the byte order of the machine
+	*** Added with Version 1.9
+	*/
+	namespace wyhash {
+		inline _ull_ read8(const unsigned char *p) { _ull_ v; memcpy(&v, p, 8); return v; }
+		inline _ull_ read4(const unsigned char *p) { unsigned v; memcpy(&v, p, 4); return v; }
+		inline _ull_ read3(const unsigned char *p, unsigned k) { return ((_ull_)p[0] << 16) | ((_ull_)p[k >> 1] << 8) | p[k - 1]; }
+
+		/* 128 bit product of "a" and "b", low half to "a", high half to "b" */
+		inline void mum(_ull_ &a, _ull_ &b) {
+#if defined(__SIZEOF_INT128__)
+			__extension__ typedef unsigned __int128 u128;
+			u128 r = (u128)a * b;
+			a = (_ull_)r;
+			b = (_ull_)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			a = _umul128(a, b, &b);
+#else
+			_ull_ ha = a >> 32, hb = b >> 32, la = (unsigned)a, lb = (unsigned)b;
+			_ull_ rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32), c = t < rl;
+			_ull_ lo = t + (rm1 << 32);
+			c += lo < t;
+			a = lo;
+			b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+		}
+		inline _ull_ mix(_ull_ a, _ull_ b) { mum(a, b); return a ^ b; }
+
+		/* key readers of hash_words(): plain bytes ... */
+		struct raw_words {
+			static _ull_ read(const unsigned char *p) { return read8(p); }
+			static _ull_ read_4(const unsigned char *p) { return read4(p); }
+			static _ull_ read_3(const unsigned char *p, unsigned k) { return read3(p, k); }
+		};
+		/* ... or with the ASCII letters among the code units of N bytes folded to lower case */
+		template <unsigned N>
+		struct folded_words {
+			/* SWAR: sets bit 5 of the lanes of N bytes of "v" within ['A', 'Z'] (the double shift avoids shifting by the word width) */
+			template <typename W>
+			static W fold(W v) {
+				const W ones = (W)~(W)0 / (W)(((W)1 << (4 * N) << (4 * N)) - 1), high = (W)(ones << (8 * N - 1)), bias = (W)((W)1 << (8 * N - 1));
+				W t = v & ~high;
+				/* no carries between lanes: "t" has the top bit of every lane cleared */
+				W letter = (W)(t + ones * (W)(bias - 'A')) & (W)~(W)(t + ones * (W)(bias - 'Z' - 1)) & (W)~v & high;
+				return v | (W)(letter >> (8 * N - 6));
+			}
+			static _ull_ read(const unsigned char *p) { return fold(read8(p)); }
+			static _ull_ read_4(const unsigned char *p) { unsigned v; memcpy(&v, p, 4); return fold(v); }
+			static _ull_ read_3(const unsigned char *p, unsigned k) {
+				unsigned char b[4] = { 0 };
+				unsigned v;
+				memcpy(b, p, k);
+				memcpy(&v, b, 4);
+				v = fold(v);
+				memcpy(b, &v, 4);
+				return read3(b, k);
+			}
+		};
 
+		/* hash "n" bytes at "p", read by R (raw_words or folded_words<N>) */
+		template <typename R>
+		inline _ull_ hash_words(const unsigned char *p, unsigned n, _ull_ seed) {
+			static const _ull_ secret[4] = { 0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL };
+			_ull_ a, b;
+			seed ^= mix(seed ^ secret[0], secret[1]);
+			if (n <= 16) {
+				if (n >= 4) {
+					a = (R::read_4(p) << 32) | R::read_4(p + ((n >> 3) << 2));
+					b = (R::read_4(p + n - 4) << 32) | R::read_4(p + n - 4 - ((n >> 3) << 2));
+				}
+				else if (n > 0) { a = R::read_3(p, n); b = 0; }
+				else a = b = 0;
+			}
+			else {
+				unsigned i = n;
+				if (i > 48) {
+					_ull_ see1 = seed, see2 = seed;
+					do {
+						seed = mix(R::read(p) ^ secret[1], R::read(p + 8) ^ seed);
+						see1 = mix(R::read(p + 16) ^ secret[2], R::read(p + 24) ^ see1);
+						see2 = mix(R::read(p + 32) ^ secret[3], R::read(p + 40) ^ see2);
+						p += 48;
+						i -= 48;
+					} while (i > 48);
+					seed ^= see1 ^ see2;
+				}
+				while (i > 16) {
+					seed = mix(R::read(p) ^ secret[1], R::read(p + 8) ^ seed);
+					i -= 16;
+					p += 16;
+				}
+				a = R::read(p + i - 16);
+				b = R::read(p + i - 8);
+			}
+			a ^= secret[1];
+			b ^= seed;
+			mum(a, b);
+			return mix(a ^ secret[0] ^ n, b ^ secret[1]);
+		}
+		/* hash "n" bytes at "key" */
+		inline _ull_ hash(const void *key, unsigned n, _ull_ seed) { return hash_words<raw_words>((const unsigned char *)key, n, seed); }
 		/*
-		*** string_base<T> &assign(const T *)
-		*** assign c_str's value to this string 
-		*** old data is lost once you call this function
-		*** performs a reallocation with adjusted size and capacity 
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimization, using memcpy() now
+		*** hash "n" bytes at "key" (code units of N bytes) as if the ASCII letters 
+		were lower case, equal to hash() of the folded value
+		*** every word is read at a multiple of N bytes, so the lanes match the code units
 		*/
-		string_base<T> &assign(const T *c_str) {
-			if (!*c_str) return (*this);
-			delete[] raw_data;
-			len = strlength<T>(c_str);
-			cap = len + 1;
-			raw_data = new T[cap];
-			memcpy(raw_data, c_str, len * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
+		template <unsigned N>
+		inline _ull_ ihash(const void *key, unsigned n, _ull_ seed) { return hash_words<folded_words<N> >((const unsigned char *)key, n, seed); }
+	} /* namespace "wyhash" */
+
+	/*
+	*** _ull_ hash_bytes(const void *, unsigned, _ull_)
+	*** returns the 64 bit hash value of the "n" bytes at "data" (see namespace wyhash)
+	*** Added with Version 1.9
+	*/
+	inline _ull_ hash_bytes(const void *data, unsigned n, _ull_ seed = 0ULL) { return wyhash::hash(data, n, seed); }
+	/*
+	*** _ull_ ihash_chars(const T *, unsigned, _ull_)
+	*** returns the 64 bit hash value of the "count" chars at "s" with ASCII 
+	letters folded to lower case (see simd::fold()), without copying them
+	*** strings which are equal by iequals() have equal values, it's the 
+	value of hash_bytes() of the lower case string
+	*** Added with Version 1.9
+	*/
+	template <typename T>
+	inline _ull_ ihash_chars(const T *s, unsigned count, _ull_ seed = 0ULL) { return wyhash::ihash<sizeof(T)>(s, count * sizeof(T), seed); }
+
+	/*
+	*********************************************************************
+	*** number parsing												  ***
+	*********************************************************************
+	*** from_chars()-like conversion of chars of any type T to integers and
+	floating point values: works on (pointer, length), needs no null-terminator
+	and never allocates
+	*** integers: [-]digits in base 2 to 36 (letters in both cases), '-' only
+	for signed types; floating point values: [-]digits[.digits][(e|E)[+|-]digits],
+	"inf", "infinity" and "nan" (any case); no leading whitespace and no '+'
+	*** decimal integers are checked and converted 8 digits at once (SWAR, the
+	8 chars are packed into the byte lanes of a 64 bit register)
+	*** float and double are rounded correctly by the Eisel-Lemire algorithm
+	(one or two 64 x 128 bit products with a table of powers of five); inputs
+	with more than 19 significant digits it can't decide (and long double) are
+	converted by strtod() / strtof() / strtold() from a stack buffer
+	*** Added with Version 1.9
+	*/
+	enum parse_error {
+		parse_ok = 0,		/* value has been converted */
+		parse_invalid,		/* no number at all, value is unchanged */
+		parse_range			/* number doesn't fit into the type (see parse_number()) */
+	};
+	struct parse_result {
+		unsigned pos;		/* position of the first char behind the number, or where the error was found */
+		parse_error error;	/* parse_ok on success */
+		bool ok() const { return error == parse_ok; }
+	};
+
+	namespace numeric {
+		/* value of the digit "c" (0 - 35), 36 if it's none */
+		template <typename T>
+		inline unsigned digit(T c) {
+			if (c >= T('0') && c <= T('9')) return (unsigned)(c - T('0'));
+			if (c >= T('a') && c <= T('z')) return (unsigned)(c - T('a')) + 10;
+			if (c >= T('A') && c <= T('Z')) return (unsigned)(c - T('A')) + 10;
+			return 36;
+		}
+		template <typename T>
+		inline unsigned digit10(T c) { return (c >= T('0') && c <= T('9')) ? (unsigned)(c - T('0')) : 10; }
+		/* case-insensitive check whether "n" chars at "s" start with the lower case ASCII "word" */
+		template <typename T>
+		inline bool starts_with_word(const T *s, unsigned n, const char *word) {
+			for (unsigned i = 0; word[i]; i++)
+				if (i >= n || (s[i] != T(word[i]) && s[i] != T(word[i] - 'a' + 'A'))) return false;
+			return true;
+		}
+
+		/* pack 8 chars into the bytes of a 64 bit value (first char = lowest byte), chars above 0xFF become 0xFF */
+		template <typename T>
+		inline _ull_ load8(const T *p) {
+			_ull_ v = 0;
+			for (unsigned i = 0; i < 8; i++) {
+				unsigned b = (sizeof(T) == 1) ? (unsigned)(unsigned char)p[i] : (((_ull_)p[i] <= 0xFFULL) ? (unsigned)p[i] : 0xFFU);
+				v |= (_ull_)b << (i * 8);
+			}
+			return v;
 		}
+		/* checks whether all 8 bytes of "v" are ASCII digits */
+		inline bool eight_digits(_ull_ v) {
+			return ((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+		}
+		/* value of the 8 ASCII digits in "v" (lowest byte = most significant digit) */
+		inline unsigned parse_eight(_ull_ v) {
+			v -= 0x3030303030303030ULL;
+			v = (v * 10) + (v >> 8);	/* pairs of digits */
+			v = (((v & 0x000000FF000000FFULL) * 0x000F424000000064ULL) + (((v >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >> 32;
+			return (unsigned)v;
+		}
+
 		/*
-		*** string_base<T> &assign(const T *, unsigned)
-		*** assigns the first "len" characters of "c_str" to this string
-		*** old data is lost once you call this function
-		*** performs a reallocation with adjusted size and capacity
-		*** returns (modified) *this object
-		*** Version 1.2: Optimization, using memcpy() now
-		*** Version 1.3.5: 
-				raw_data[len] = 0x00; 
-			has been changed to
-				raw_data[this->len] = 0x00;
+		*** reads the digits from "i" on as unsigned value, returns the position behind them
+		*** "over" is set if the value doesn't fit into 64 bits (all digits are consumed anyway)
 		*/
-		string_base<T> &assign(const T *c_str, unsigned len) {
-			if (!*c_str || !len) return (*this);
-			unsigned ac_len = MIN(len, strlength<T>(c_str));
-			delete[] raw_data;
-			this->len = ac_len;
-			cap = this->len + 1;
-			raw_data = new T[cap];
-			memcpy(raw_data, c_str, this->len * sizeof(T));
-			raw_data[this->len] = 0x00;
-			return (*this);
+		template <typename T>
+		unsigned parse_digits(const T *s, unsigned n, unsigned i, unsigned base, _ull_ &value, bool &over) {
+			_ull_ v = 0;
+			over = false;
+			if (base == 10) {
+				while (i < n && s[i] == T('0')) i++;
+				unsigned sig = i;	/* first significant digit, 19 digits always fit */
+				while (n - i >= 8 && i - sig <= 11) {
+					_ull_ b = load8(s + i);
+					if (!eight_digits(b)) break;
+					v = v * 100000000ULL + parse_eight(b);
+					i += 8;
+				}
+				for (unsigned d; i < n && i - sig < 19 && (d = digit10(s[i])) < 10; i++) v = v * 10 + d;
+				if (i < n && digit10(s[i]) < 10) {
+					unsigned d = digit10(s[i++]);
+					if (v > (~0ULL - d) / 10) over = true;
+					else v = v * 10 + d;
+					for (; i < n && digit10(s[i]) < 10; i++) over = true;
+				}
+			}
+			else {
+				for (unsigned d; i < n && (d = digit(s[i])) < base; i++) {
+					if (v > (~0ULL - d) / base) over = true;
+					v = v * base + d;
+				}
+			}
+			value = v;
+			return i;
 		}
+
+		/* limits of the integer type N */
+		template <typename N>
+		struct int_limits {
+			enum { is_signed = (N)~(N)0 < (N)0 };
+			static _ull_ max() { return is_signed ? (((_ull_)1 << (sizeof(N) * 8 - 1)) - 1) : (_ull_)(N)~(N)0; }
+		};
+
 		/*
-		*** string_base<T> &assign(const string_base<T> &)
-		*** assign str's value to this string 
-		*** old data is lost once you call this function
-		*** performs a reallocation with adjusted size and capacity
-		*** does nothing if 
-			-> you try to assign *this to this string
-			-> str's length is 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimization, using memcpy() now
+		*********************************************************************
+		*** Eisel-Lemire													***
+		*********************************************************************
+		*** (Daniel Lemire, "Number Parsing at a Gigabyte per Second", 2021
+		and Noble Mushtak, Daniel Lemire, "Fast Number Parsing Without Fallback", 2023)
 		*/
-		string_base<T> &assign(const string_base<T> &str) {
-			if (this == &str) return (*this);
-			delete[] raw_data;
-			len = str.len;
-			cap = len + 1;
-			raw_data = new T[cap];
-			memcpy(raw_data, str.raw_data, len * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
-		}
-#ifdef STR_USE_BINDINGS
+
 		/*
-		*** string_base<T> &assign(const str_string &)
-		*** assign str's value to this string
-		*** old data is lost once you call this function
-		*** performs a reallocation with adjusted size and capacity
-		*** does nothing if
-			-> str's length is 0
-		*** returns (eventually modified) *this object
-		*** Added with Version 1.4
+		*** exact big integer helpers to build the tables of powers of five below
+		*** numbers are little endian arrays of 32 bit limbs with their length
 		*/
-		string_base<T> &assign(const std_string &str) {
-			delete[] raw_data;
-			len = str.length();
-			cap = len + 1;
-			raw_data = new T[cap];
-			memcpy(raw_data, str.c_str(), len * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
-		}
-#endif
+		struct bignum {
+			/* a *= m, returns the new length */
+			static unsigned mul_small(unsigned *a, unsigned n, unsigned m) {
+				_ull_ c = 0;
+				for (unsigned i = 0; i < n; i++) { c += (_ull_)a[i] * m; a[i] = (unsigned)c; c >>= 32; }
+				if (c) a[n++] = (unsigned)c;
+				return n;
+			}
+			/* a = floor(a / m), returns the new length */
+			static unsigned div_small(unsigned *a, unsigned n, unsigned m) {
+				_ull_ r = 0;
+				for (unsigned i = n; i-- > 0;) { r = (r << 32) | a[i]; a[i] = (unsigned)(r / m); r %= m; }
+				while (n > 1 && !a[n - 1]) n--;
+				return n;
+			}
+			/* a = floor(a / 5^k) (floor(floor(a / x) / y) == floor(a / (x * y))) */
+			static unsigned div_pow5(unsigned *a, unsigned n, int k) {
+				for (; k > 0; k -= 13) {
+					unsigned m = 1;
+					for (int i = (k > 13) ? 13 : k; i > 0; i--) m *= 5;
+					n = div_small(a, n, m);
+				}
+				return n;
+			}
+			/* a += 1, returns the new length */
+			static unsigned inc(unsigned *a, unsigned n) {
+				unsigned i = 0;
+				while (i < n && ++a[i] == 0) i++;
+				if (i == n) a[n++] = 1;
+				return n;
+			}
+			static unsigned bit_length(const unsigned *a, unsigned n) {
+				unsigned b = 32 * (n - 1), top = a[n - 1];
+				while (top) { b++; top >>= 1; }
+				return b;
+			}
+			/* the 128 bits of "a" starting at bit "lo" (negative: shifted up) */
+			static void bits128(const unsigned *a, unsigned n, int lo, _ull_ &high, _ull_ &low) {
+				_ull_ w[2] = { 0, 0 };
+				for (int i = 0; i < 128; i++) {
+					int bit = lo + i;
+					if (bit >= 0 && bit < (int)(32 * n) && ((a[bit / 32] >> (bit % 32)) & 1)) w[i / 64] |= (_ull_)1 << (i % 64);
+				}
+				high = w[1];
+				low = w[0];
+			}
+		};
+
 		/*
-		*** string_base<T> &assign(const T &, unsigned len)
-		*** assigns ch's value to this string (actually, "len" times)
-		*** old data is lost once you call this function
-		*** performs a reallocation with adjusted size and capacity
-		*** returns (modified) *this object
+		*** 128 bit approximations of 5^q for q in [-342, 308], two 64 bit
+		words per power (high word first), most significant bit set
+		*** positive powers are truncated, negative ones are 2^b / 5^-q + 1
+		*** built exactly with big integers once on first use instead of
+		being spelled out as 1302 constants
 		*/
-		string_base<T> &assign(const T &ch, unsigned len) {
-			if (!len) return (*this);
-			delete[] raw_data;
-			this->len = len;
-			cap = len + 1;
-			raw_data = new T[cap];
-			for (unsigned i = 0; i < cap; i++)
-				raw_data[i] = ch;
-			raw_data[len] = 0x00;
-			return (*this);
+		enum { pow5_min = -342, pow5_max = 308 };
+		struct pow5_table {
+			_ull_ v[2 * (pow5_max - pow5_min + 1)];
+
+			pow5_table() {
+				unsigned p[26] = { 1 };	/* 5^q (5^342 < 2^800) */
+				unsigned pl = 1, bits[-pow5_min + 1];
+				for (int q = 0; q <= -pow5_min; q++) {
+					if (q) pl = bignum::mul_small(p, pl, 5);
+					bits[q] = bignum::bit_length(p, pl);
+					if (q <= pow5_max) top128(p, pl, &v[2 * (q - pow5_min)]);
+				}
+				for (int k = 1; k <= -pow5_min; k++) {
+					unsigned z = bits[k], b = (k <= 27) ? (z + 127) : (2 * z + 128);
+					unsigned d[56] = { 0 }, dl = b / 32 + 1;	/* 2^b / 5^k, b < 1720 */
+					d[b / 32] = 1U << (b % 32);
+					dl = bignum::inc(d, bignum::div_pow5(d, dl, k));
+					top128(d, dl, &v[2 * (-k - pow5_min)]);
+				}
+			}
+			/* the 128 most significant bits (shifted up if there are less) */
+			static void top128(const unsigned *a, unsigned n, _ull_ *out) {
+				bignum::bits128(a, n, (int)bignum::bit_length(a, n) - 128, out[0], out[1]);
+			}
+		};
+		inline const _ull_ *pow5() {
+			static const pow5_table t;	/* thread-safe initialization with C++11 */
+			return t.v;
 		}
+
+		/* binary layout of float and double */
+		template <typename F> struct float_format;
+		template <> struct float_format<double> {
+			typedef _ull_ bits;
+			enum { mantissa_bits = 52, min_exponent = -1023, infinite_power = 0x7FF,
+				min_pow10 = -342, max_pow10 = 308, min_round_even = -4, max_round_even = 23 };
+		};
+		template <> struct float_format<float> {
+			typedef unsigned bits;
+			enum { mantissa_bits = 23, min_exponent = -127, infinite_power = 0xFF,
+				min_pow10 = -64, max_pow10 = 38, min_round_even = -17, max_round_even = 10 };
+		};
+
 		/*
-		*** string_base<T> &assign(string_base<T> &, unsigned, unsigned)
-		*** assigns a substring of "str" (starting at "start" with a length 
-		of "count") to this string
-		*** old data is lost once you call this function
-		*** performs a reallocation with adjusted size and capacity
-		*** does nothing if 
-			-> you try to assign *this with same length to this string
-			-> substring's length ("count") == 0
-		*** if "start" is greater than str's length, then start = 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimization, using memcpy() now
-		*** based on this article: https://www.includehelp.com/c-programs/substring-implementation.aspx
+		*** computes the binary mantissa and exponent of w * 10^q (w != 0), correctly rounded
+		*** returns power2 == infinite_power on overflow, mantissa == power2 == 0 on underflow
 		*/
-		string_base<T> &assign(const string_base<T> &str, unsigned start, unsigned count) {
-			if (!count || (this == &str && start == 0 && count == len))
-				return (*this);
-			unsigned l = str.len;
-			if (start > l) start = 0;
-			if ((start + count) > l) 
-				count = (l - start);
-			len = count; cap = len + 1;
-			delete[] raw_data;
-			raw_data = new T[cap];
-			memcpy(raw_data, str.raw_data + start, len * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
+		template <typename F>
+		void eisel_lemire(int q, _ull_ w, _ull_ &mantissa, int &power2) {
+			typedef float_format<F> fmt;
+			mantissa = 0;
+			power2 = 0;
+			if (q < (int)fmt::min_pow10) return;
+			if (q > (int)fmt::max_pow10) { power2 = fmt::infinite_power; return; }
+			int lz = (w >> 32) ? (31 - (int)simd::highest_bit((unsigned)(w >> 32))) : (63 - (int)simd::highest_bit((unsigned)w));
+			w <<= lz;
+			/* 64 x 128 bit product, the low word is only needed if the high one is ambiguous */
+			const _ull_ *p = pow5() + 2 * (q - (int)pow5_min);
+			_ull_ lo = w, hi = p[0];
+			wyhash::mum(lo, hi);
+			const _ull_ mask = ~0ULL >> (fmt::mantissa_bits + 3);
+			if ((hi & mask) == mask) {
+				_ull_ lo2 = w, hi2 = p[1];
+				wyhash::mum(lo2, hi2);
+				lo += hi2;
+				if (hi2 > lo) hi++;
+			}
+			int upper = (int)(hi >> 63);
+			int shift = upper + 64 - fmt::mantissa_bits - 3;
+			mantissa = hi >> shift;
+			power2 = (int)((((152170 + 65536) * q) >> 16) + 63) + upper - lz - fmt::min_exponent;
+			if (power2 <= 0) {	/* subnormal */
+				if (-power2 + 1 >= 64) { mantissa = 0; power2 = 0; return; }
+				mantissa >>= -power2 + 1;
+				mantissa += (mantissa & 1);
+				mantissa >>= 1;
+				power2 = (mantissa < ((_ull_)1 << fmt::mantissa_bits)) ? 0 : 1;
+				return;
+			}
+			/* exactly halfway between two floats: round to even */
+			if (lo <= 1 && q >= (int)fmt::min_round_even && q <= (int)fmt::max_round_even && (mantissa & 3) == 1 && (mantissa << shift) == hi)
+				mantissa &= ~(_ull_)1;
+			mantissa += (mantissa & 1);
+			mantissa >>= 1;
+			if (mantissa >= ((_ull_)2 << fmt::mantissa_bits)) {
+				mantissa = (_ull_)1 << fmt::mantissa_bits;
+				power2++;
+			}
+			mantissa &= ~((_ull_)1 << fmt::mantissa_bits);
+			if (power2 >= (int)fmt::infinite_power) { power2 = fmt::infinite_power; mantissa = 0; }
 		}
-#ifdef STR_USE_BINDINGS
-		/*
-		*** string_base<T> &assign(const std_string &, unsigned, unsigned)
-		*** assigns a substring of "str" (starting at "start" with a length 
-		of "count") to this string
-		*** old data is lost once you call this function
-		*** performs a reallocation with adjusted size and capacity
-		*** does nothing if
-			-> substring's length ("count") == 0
-		*** if "start" is greater than str's length, then start = 0
-		*** returns (eventually modified) *this object
-		*** Added with Verson 1.4
-		*/
-		string_base<T> &assign(const std_string &str, unsigned start, unsigned count) {
-			return assign(str.c_str(), start, count);
+		template <typename F>
+		F make_float(_ull_ mantissa, int power2) {
+			typedef typename float_format<F>::bits bits;
+			bits b = (bits)(mantissa | ((_ull_)power2 << float_format<F>::mantissa_bits));
+			F f;
+			memcpy(&f, &b, sizeof(f));
+			return f;
 		}
-#endif
+
+		/* conversion of the normalized chars in "buf" by the C library */
+		inline void strto(const char *buf, double &v) { v = strtod(buf, NULL); }
+		inline void strto(const char *buf, float &v) { v = strtof(buf, NULL); }
+		inline void strto(const char *buf, _ld_ &v) { v = strtold(buf, NULL); }
+
 		/*
-		*** string_base<T> &assign(const T *, unsigned, unsigned)
-		*** assigns a substring of "c_str" (starting at "start" with a length
-		of "count") to this string
-		*** old data is lost once you call this function
-		*** performs a reallocation with adjusted size and capacity
-		*** does nothing if
-		-> c_str's value == ""
-		-> substring's length ("count") == 0
-		*** if "start" is greater than c_str's length, then start = 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Added this assign overload
+		*** slow path: copies the digits of s[i, e) into a stack buffer as
+		digits "e" exponent (no decimal point, so the locale doesn't matter)
+		and lets the C library round it
+		*** keeps 768 significant digits (enough for double) plus a sticky
+		'1' if any further digit isn't 0
 		*/
-		string_base<T> &assign(const T *c_str, unsigned start, unsigned count) {
-			if (!*c_str || !count) return (*this);
-			unsigned l = strlength<T>(c_str);
-			if (start > l) start = 0;
-			if ((start + count) > l)
-				count = (l - start);
-			len = count; cap = len + 1;
-			delete[] raw_data;
-			raw_data = new T[cap];
-			memcpy(raw_data, c_str + start, len * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
+		template <typename T, typename F>
+		void slow_float(const T *s, unsigned i, unsigned e, int exp10, F &v) {
+			char buf[800];
+			unsigned k = 0, nd = 0;
+			long ex = exp10;
+			bool frac = false, sticky = false;
+			for (; i < e; i++) {
+				if (s[i] == T('.')) { frac = true; continue; }
+				unsigned d = digit10(s[i]);
+				if (!nd && !d) { if (frac) ex--; continue; }		/* leading zero */
+				if (nd < 768) { buf[k++] = (char)('0' + d); nd++; if (frac) ex--; }
+				else { if (d) sticky = true; if (!frac) ex++; }
+			}
+			if (sticky) { buf[k++] = '1'; ex--; }
+			if (!nd) buf[k++] = '0';
+			if (ex > 99999) ex = 99999;
+			if (ex < -99999) ex = -99999;
+			buf[k++] = 'e';
+			if (ex < 0) { buf[k++] = '-'; ex = -ex; }
+			char tmp[8];
+			unsigned t = 0;
+			do { tmp[t++] = (char)('0' + ex % 10); ex /= 10; } while (ex);
+			while (t) buf[k++] = tmp[--t];
+			buf[k] = 0;
+			strto(buf, v);
 		}
 
 		/*
-		*** string_base<T> &append(const T *)
-		*** append c_str's value to this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> first character of c_str's value == 0x00
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimization, using memcpy() now
-		*** Version 1.6: Added assertions to make debugging the program easier 
+		*** hexadecimal floats ("0x1.8p3") for stod() and co., like strtod(): copies 
+		the hex digits behind "0x" into a stack buffer as 0x digits "p" exponent 
+		(no decimal point, so the locale doesn't matter) and lets the C library round it
+		*** keeps 768 significant digits plus a sticky '1' like slow_float()
+		*** returns false if "s" doesn't start with "0x" followed by a hex digit
 		*/
-		string_base<T> &append(const T *c_str) {
-			if (!*c_str) return (*this);
-			unsigned old = len, l = strlength<T>(c_str);
-			if (cap <= (len += l)) {
-				cap += (l + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
+		template <typename T, typename F>
+		bool hex_float(const T *s, unsigned n, F &v) {
+			if (n < 3 || s[0] != T('0') || (s[1] != T('x') && s[1] != T('X'))) return false;
+			unsigned i = 2;
+			if (digit(s[i]) >= 16 && (s[i] != T('.') || n < 4 || digit(s[i + 1]) >= 16)) return false;
+			char buf[800];
+			unsigned k = 2, nd = 0;
+			long ex = 0;
+			bool frac = false, sticky = false;
+			buf[0] = '0'; buf[1] = 'x';
+			for (unsigned d; i < n; i++) {
+				if (s[i] == T('.') && !frac) { frac = true; continue; }
+				if ((d = digit(s[i])) >= 16) break;
+				if (!nd && !d) { if (frac) ex -= 4; continue; }	/* leading zero */
+				if (nd < 768) { buf[k++] = "0123456789abcdef"[d]; nd++; if (frac) ex -= 4; }
+				else { if (d) sticky = true; if (!frac) ex += 4; }
 			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL); 
-#endif
-			memcpy(raw_data + old, c_str, (len - old) * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
+			if (sticky) { buf[k++] = '1'; ex -= 4; }
+			if (!nd) buf[k++] = '0';
+			/* binary exponent, only consumed if at least one digit follows */
+			if (i + 1 < n && (s[i] == T('p') || s[i] == T('P'))) {
+				unsigned j = i + 1;
+				bool eneg = false;
+				if (s[j] == T('-') || s[j] == T('+')) { eneg = s[j] == T('-'); j++; }
+				long e2 = 0;
+				for (unsigned d; j < n && (d = digit10(s[j])) < 10; j++)
+					if (e2 < 1000000) e2 = e2 * 10 + (long)d;
+				ex += eneg ? -e2 : e2;
+			}
+			if (ex > 999999) ex = 999999;
+			if (ex < -999999) ex = -999999;
+			buf[k++] = 'p';
+			if (ex < 0) { buf[k++] = '-'; ex = -ex; }
+			char tmp[8];
+			unsigned t = 0;
+			do { tmp[t++] = (char)('0' + ex % 10); ex /= 10; } while (ex);
+			while (t) buf[k++] = tmp[--t];
+			buf[k] = 0;
+			strto(buf, v);
+			return true;
+		}
+
+		/* checks whether the floating point value "v" is finite (no inf or nan) */
+		template <typename F>
+		inline bool finite(F v) { return v == v && v - v == v - v; }
+
+		/* fast path for float and double, slow path for long double */
+		template <typename F>
+		bool fast_float(int q, _ull_ w, bool trunc, F &v) {
+			_ull_ m;
+			int p;
+			eisel_lemire<F>(q, w, m, p);
+			if (trunc) {	/* the real mantissa is between w and w + 1 */
+				_ull_ m2;
+				int p2;
+				eisel_lemire<F>(q, w + 1, m2, p2);
+				if (m != m2 || p != p2) return false;
+			}
+			v = make_float<F>(m, p);
+			return true;
+		}
+		template <>
+		inline bool fast_float<_ld_>(int, _ull_, bool, _ld_ &) { return false; }
+
+		/* parse a floating point value of type F (float, double or long double) */
+		template <typename T, typename F>
+		parse_result parse_float(const T *s, unsigned n, F &value) {
+			parse_result res = { 0, parse_invalid };
+			unsigned i = 0;
+			bool neg = false;
+			if (n && s[0] == T('-')) { neg = true; i = 1; }
+			unsigned start = i;
+
+			if (starts_with_word(s + i, n - i, "inf")) {
+				res.pos = i + (starts_with_word(s + i, n - i, "infinity") ? 8 : 3);
+				res.error = parse_ok;
+				F inf = (F)1e30;
+				while (finite(inf)) inf *= inf;
+				value = neg ? -inf : inf;
+				return res;
+			}
+			if (starts_with_word(s + i, n - i, "nan")) {
+				res.pos = i + 3;
+				res.error = parse_ok;
+				F inf = (F)1e30;
+				while (finite(inf)) inf *= inf;
+				value = inf - inf;
+				if (neg) value = -value;
+				return res;
+			}
+
+			/* mantissa: the first 19 significant digits go to "w", 8 digits at once if possible */
+			_ull_ w = 0;
+			int nd = 0, exp10 = 0;
+			bool any = false, trunc = false;
+			for (unsigned d; i < n && (d = digit10(s[i])) < 10; i++) {
+				any = true;
+				if (nd && nd <= 11 && n - i >= 8) {
+					_ull_ b = load8(s + i);
+					if (eight_digits(b)) { w = w * 100000000ULL + parse_eight(b); nd += 8; i += 7; continue; }
+				}
+				if (!nd && !d) continue;
+				if (nd < 19) { w = w * 10 + d; nd++; }
+				else { exp10++; if (d) trunc = true; }
+			}
+			if (i < n && s[i] == T('.')) {
+				i++;
+				for (unsigned d; i < n && (d = digit10(s[i])) < 10; i++) {
+					any = true;
+					if (nd && nd <= 11 && n - i >= 8) {
+						_ull_ b = load8(s + i);
+						if (eight_digits(b)) { w = w * 100000000ULL + parse_eight(b); nd += 8; exp10 -= 8; i += 7; continue; }
+					}
+					if (!nd && !d) { exp10--; continue; }
+					if (nd < 19) { w = w * 10 + d; nd++; exp10--; }
+					else if (d) trunc = true;
+				}
+			}
+			if (!any) { res.pos = start; return res; }
+			unsigned end = i;
+
+			/* exponent, only consumed if at least one digit follows */
+			int e10 = 0;
+			if (i < n && (s[i] == T('e') || s[i] == T('E'))) {
+				unsigned j = i + 1;
+				bool eneg = false;
+				if (j < n && (s[j] == T('-') || s[j] == T('+'))) { eneg = s[j] == T('-'); j++; }
+				if (j < n && digit10(s[j]) < 10) {
+					for (unsigned d; j < n && (d = digit10(s[j])) < 10; j++)
+						if (e10 < 100000) e10 = e10 * 10 + (int)d;
+					if (eneg) e10 = -e10;
+					i = j;
+				}
+			}
+			res.pos = i;
+			res.error = parse_ok;
+
+			F v = 0;	/* magnitude */
+			if (w && !fast_float(exp10 + e10, w, trunc, v)) slow_float(s, start, end, e10, v);
+			if (w && (!finite(v) || v == 0)) res.error = parse_range;
+			value = neg ? -v : v;
+			return res;
+		}
+
+		/* parse an integer of type N */
+		template <typename T, typename N>
+		parse_result parse_int(const T *s, unsigned n, N &value, unsigned base) {
+			parse_result res = { 0, parse_invalid };
+			if (base < 2 || base > 36) return res;
+			unsigned i = 0;
+			bool neg = false;
+			if (n && s[0] == T('-')) {
+				if (!int_limits<N>::is_signed) return res;
+				neg = true;
+				i = 1;
+			}
+			_ull_ v;
+			bool over;
+			unsigned e = parse_digits(s, n, i, base, v, over);
+			res.pos = e;
+			if (e == i) return res;
+			_ull_ lim = int_limits<N>::max() + (neg ? 1 : 0);
+			if (over || v > lim) { res.error = parse_range; return res; }
+			value = neg ? (v ? (N)(-(N)(v - 1) - 1) : (N)0) : (N)v;
+			res.error = parse_ok;
+			return res;
+		}
+
+		/* conversion for string_base<T>::stol() and co., the sign has been read already */
+		template <typename T, typename N>
+		N sto(const T *s, unsigned n, bool neg, N *) {
+			_ull_ v = 0;
+			parse_result r = parse_int(s, n, v, 10);
+			if (r.error == parse_invalid) return N(0);
+			_ull_ max = int_limits<N>::max();
+			if (int_limits<N>::is_signed) {
+				if (r.error == parse_range || v > max + neg) v = max + neg;
+				return neg ? (v ? (N)(-(N)(v - 1) - 1) : N(0)) : (N)v;
+			}
+			if (r.error == parse_range || v > max) return (N)max;
+			return neg ? (N)(0 - v) : (N)v;
+		}
+		template <typename T, typename F>
+		F sto_float(const T *s, unsigned n, bool neg) {
+			F v = 0;
+			if (!hex_float(s, n, v)) parse_float(s, n, v);
+			return neg ? -v : v;
 		}
+		template <typename T> float sto(const T *s, unsigned n, bool neg, float *) { return sto_float<T, float>(s, n, neg); }
+		template <typename T> double sto(const T *s, unsigned n, bool neg, double *) { return sto_float<T, double>(s, n, neg); }
+		template <typename T> _ld_ sto(const T *s, unsigned n, bool neg, _ld_ *) { return sto_float<T, _ld_>(s, n, neg); }
+
 		/*
-		*** string_base<T> &append(const T &)
-		*** appends ch's value to this string 
-		*** allocates much more memory if needed
-		*** returns (modified) *this object
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*********************************************************************
+		*** number formatting												***
+		*********************************************************************
 		*/
-		string_base<T> &append(const T &ch) {
-			if (cap <= (len += 1)) {
-				cap += (1 + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
+
+		/* "00", "01", ..., "99": two digits per division */
+		inline const char *digit_pairs() {
+			return "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+				"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+				"8081828384858687888990919293949596979899";
+		}
+		/* number of decimal digits of "v" */
+		template <typename U>
+		inline unsigned count_digits(U v) {
+			unsigned n = 1;
+			for (;;) {
+				if (v < 10) return n;
+				if (v < 100) return n + 1;
+				if (v < 1000) return n + 2;
+				if (v < 10000) return n + 3;
+				v /= 10000U;
+				n += 4;
 			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
-#endif
-			raw_data[len - 1] = ch;
-			raw_data[len] = 0x00;
-			return (*this);
 		}
+		/* writes the digits of "v" backwards, ending right before "end" */
+		template <typename T, typename U>
+		inline void write_uint(T *end, U v) {
+			const char *pairs = digit_pairs();
+			while (v >= 100) {
+				unsigned i = (unsigned)(v % 100U) * 2;
+				v /= 100U;
+				*--end = T(pairs[i + 1]);
+				*--end = T(pairs[i]);
+			}
+			if (v >= 10) {
+				*--end = T(pairs[v * 2 + 1]);
+				*--end = T(pairs[v * 2]);
+			}
+			else *--end = T('0' + (unsigned)v);
+		}
+
+		/* sign of any integer type without "always false" warnings for unsigned ones */
+		template <bool Signed> struct sign_of {
+			template <typename N> static bool negative(N v) { return v < N(0); }
+		};
+		template <> struct sign_of<false> {
+			template <typename N> static bool negative(N) { return false; }
+		};
+
 		/*
-		*** string_base<T> &append(const T &, unsigned)
-		*** appends ch's value "count" times to this string
-		*** allocates much more memory if needed
-		*** does nothing if 
-			-> count == 0
-		*** returns (eventually modified) *this object
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*********************************************************************
+		*** Ryu																***
+		*********************************************************************
+		*** (Ulf Adams, "Ryu: Fast Float-to-String Conversion", PLDI 2018)
+		*** finds the shortest decimal that still rounds to the same binary
+		value; floats use the high words of the double tables
 		*/
-		string_base<T> &append(const T &ch, unsigned count) {
-			if (!count) return (*this);
-			unsigned o = len;
-			if (cap <= (len += count)) {
-				cap += (count + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
+		enum { ryu_pow5_bits = 125, ryu_pow5_inv_bits = 125, ryu_pow5_count = 326, ryu_pow5_inv_count = 342 };
+		struct ryu_table {
+			_ull_ pow5[ryu_pow5_count][2];		/* 5^i, normalized to 125 bits */
+			_ull_ inv[ryu_pow5_inv_count][2];	/* 2^(bits(5^q) - 1 + 125) / 5^q + 1 */
+
+			ryu_table() {
+				unsigned p[26] = { 1 };	/* 5^q (5^341 < 2^800) */
+				unsigned pl = 1;
+				for (int q = 0; q < (int)ryu_pow5_inv_count; q++) {
+					if (q) pl = bignum::mul_small(p, pl, 5);
+					int b = (int)bignum::bit_length(p, pl);
+					if (q < (int)ryu_pow5_count) bignum::bits128(p, pl, b - (int)ryu_pow5_bits, pow5[q][1], pow5[q][0]);
+					unsigned d[32] = { 0 }, e = (unsigned)(b - 1 + ryu_pow5_inv_bits), dl = e / 32 + 1;
+					d[e / 32] = 1U << (e % 32);
+					dl = bignum::inc(d, bignum::div_pow5(d, dl, q));
+					bignum::bits128(d, dl, 0, inv[q][1], inv[q][0]);
+				}
 			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
-#endif
-			for (unsigned i = o; i < (o + count); i++)
-				raw_data[i] = ch;
-			raw_data[len] = 0x00;
-			return (*this);
+		};
+		inline const ryu_table &ryu() {
+			static const ryu_table t;	/* thread-safe initialization with C++11 */
+			return t;
+		}
+
+		/* bits of 5^e, floor(log10(2^e)), floor(log10(5^e)) */
+		inline int pow5_bits(int e) { return (int)(((unsigned)e * 1217359U) >> 19) + 1; }
+		inline int log10_pow2(int e) { return (int)(((unsigned)e * 78913U) >> 18); }
+		inline int log10_pow5(int e) { return (int)(((unsigned)e * 732923U) >> 20); }
+		template <typename U>
+		inline bool multiple_of_pow5(U v, int p) {
+			int n = 0;
+			while (v % 5U == 0) { v /= 5U; n++; }
+			return n >= p;
+		}
+		template <typename U>
+		inline bool multiple_of_pow2(U v, int p) { return (v & (((U)1 << p) - 1)) == 0; }
+
+		/* (m * mul) >> j for the 128 bit factor "mul", 64 < j < 128 */
+		inline _ull_ mul_shift64(_ull_ m, const _ull_ *mul, int j) {
+			_ull_ lo = m, hi0 = mul[0];
+			wyhash::mum(lo, hi0);
+			_ull_ sl = m, sh = mul[1];
+			wyhash::mum(sl, sh);
+			sl += hi0;
+			if (sl < hi0) sh++;
+			return (sl >> (j - 64)) | (sh << (128 - j));
+		}
+		/* (m * factor) >> shift for a 64 bit factor, 32 < shift */
+		inline unsigned mul_shift32(unsigned m, _ull_ factor, int shift) {
+			_ull_ low = (_ull_)m * (unsigned)factor, high = (_ull_)m * (unsigned)(factor >> 32);
+			return (unsigned)(((low >> 32) + high) >> (shift - 32));
+		}
+
+		/* shortest decimal (digits * 10^exponent) of a positive finite double */
+		inline void shortest(_ull_ bits_mantissa, unsigned bits_exponent, _ull_ &digits, int &exponent) {
+			const ryu_table &t = ryu();
+			int e2;
+			_ull_ m2;
+			if (bits_exponent == 0) { e2 = 1 - 1023 - 52 - 2; m2 = bits_mantissa; }
+			else {
+				e2 = (int)bits_exponent - 1023 - 52 - 2;
+				m2 = ((_ull_)1 << 52) | bits_mantissa;
+				/* integers below 2^53 need no search */
+				if (e2 + 2 <= 0 && e2 + 2 >= -52 && multiple_of_pow2(m2, -(e2 + 2))) {
+					digits = m2 >> -(e2 + 2);
+					exponent = 0;
+					while (digits % 10 == 0) { digits /= 10; exponent++; }
+					return;
+				}
+			}
+			bool accept_bounds = (m2 & 1) == 0;
+			_ull_ mv = 4 * m2;
+			unsigned mm_shift = (bits_mantissa != 0 || bits_exponent <= 1) ? 1 : 0;
+			_ull_ vr, vp, vm;
+			int e10;
+			bool vm_zeros = false, vr_zeros = false;
+			if (e2 >= 0) {
+				int q = log10_pow2(e2) - (e2 > 3);
+				e10 = q;
+				int j = -e2 + q + (int)ryu_pow5_inv_bits + pow5_bits(q) - 1;
+				vr = mul_shift64(mv, t.inv[q], j);
+				vp = mul_shift64(mv + 2, t.inv[q], j);
+				vm = mul_shift64(mv - 1 - mm_shift, t.inv[q], j);
+				if (q <= 21) {
+					if (mv % 5 == 0) vr_zeros = multiple_of_pow5(mv, q);
+					else if (accept_bounds) vm_zeros = multiple_of_pow5(mv - 1 - mm_shift, q);
+					else vp -= multiple_of_pow5(mv + 2, q);
+				}
+			}
+			else {
+				int q = log10_pow5(-e2) - (-e2 > 1);
+				e10 = q + e2;
+				int i = -e2 - q, j = q - (pow5_bits(i) - (int)ryu_pow5_bits);
+				vr = mul_shift64(mv, t.pow5[i], j);
+				vp = mul_shift64(mv + 2, t.pow5[i], j);
+				vm = mul_shift64(mv - 1 - mm_shift, t.pow5[i], j);
+				if (q <= 1) {
+					vr_zeros = true;
+					if (accept_bounds) vm_zeros = mm_shift == 1;
+					else vp--;
+				}
+				else if (q < 63) vr_zeros = multiple_of_pow2(mv, q);
+			}
+			int removed = 0;
+			unsigned last = 0;
+			if (vm_zeros || vr_zeros) {
+				/* rare: exact bounds or ties, trailing zeros have to be tracked */
+				while (vp / 10 > vm / 10) {
+					vm_zeros &= vm % 10 == 0;
+					vr_zeros &= last == 0;
+					last = (unsigned)(vr % 10);
+					vr /= 10; vp /= 10; vm /= 10;
+					removed++;
+				}
+				if (vm_zeros) {
+					while (vm % 10 == 0) {
+						vr_zeros &= last == 0;
+						last = (unsigned)(vr % 10);
+						vr /= 10; vp /= 10; vm /= 10;
+						removed++;
+					}
+				}
+				if (vr_zeros && last == 5 && vr % 2 == 0) last = 4;	/* round to even */
+				digits = vr + (((vr == vm && (!accept_bounds || !vm_zeros)) || last >= 5) ? 1 : 0);
+			}
+			else {
+				bool up = false;
+				if (vp / 100 > vm / 100) {
+					up = vr % 100 >= 50;
+					vr /= 100; vp /= 100; vm /= 100;
+					removed += 2;
+				}
+				while (vp / 10 > vm / 10) {
+					up = vr % 10 >= 5;
+					vr /= 10; vp /= 10; vm /= 10;
+					removed++;
+				}
+				digits = vr + ((vr == vm || up) ? 1 : 0);
+			}
+			exponent = e10 + removed;
+		}
+
+		/* shortest decimal (digits * 10^exponent) of a positive finite float */
+		inline void shortest(unsigned bits_mantissa, unsigned bits_exponent, unsigned &digits, int &exponent) {
+			const ryu_table &t = ryu();
+			const int bits = (int)ryu_pow5_bits - 64, inv_bits = (int)ryu_pow5_inv_bits - 64;
+			int e2;
+			unsigned m2;
+			if (bits_exponent == 0) { e2 = 1 - 127 - 23 - 2; m2 = bits_mantissa; }
+			else { e2 = (int)bits_exponent - 127 - 23 - 2; m2 = (1U << 23) | bits_mantissa; }
+			bool accept_bounds = (m2 & 1) == 0;
+			unsigned mv = 4 * m2, mp = 4 * m2 + 2, mm_shift = (bits_mantissa != 0 || bits_exponent <= 1) ? 1 : 0;
+			unsigned mm = 4 * m2 - 1 - mm_shift, vr, vp, vm, last = 0;
+			int e10;
+			bool vm_zeros = false, vr_zeros = false;
+			if (e2 >= 0) {
+				int q = log10_pow2(e2);
+				e10 = q;
+				int j = -e2 + q + inv_bits + pow5_bits(q) - 1;
+				vr = mul_shift32(mv, t.inv[q][1] + 1, j);
+				vp = mul_shift32(mp, t.inv[q][1] + 1, j);
+				vm = mul_shift32(mm, t.inv[q][1] + 1, j);
+				if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+					/* the loop below may remove no digit, but the last removed one is needed */
+					int l = -e2 + q - 1 + inv_bits + pow5_bits(q - 1) - 1;
+					last = mul_shift32(mv, t.inv[q - 1][1] + 1, l) % 10;
+				}
+				if (q <= 9) {
+					if (mv % 5 == 0) vr_zeros = multiple_of_pow5(mv, q);
+					else if (accept_bounds) vm_zeros = multiple_of_pow5(mm, q);
+					else vp -= multiple_of_pow5(mp, q);
+				}
+			}
+			else {
+				int q = log10_pow5(-e2);
+				e10 = q + e2;
+				int i = -e2 - q, j = q - (pow5_bits(i) - bits);
+				vr = mul_shift32(mv, t.pow5[i][1], j);
+				vp = mul_shift32(mp, t.pow5[i][1], j);
+				vm = mul_shift32(mm, t.pow5[i][1], j);
+				if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+					j = q - 1 - (pow5_bits(i + 1) - bits);
+					last = mul_shift32(mv, t.pow5[i + 1][1], j) % 10;
+				}
+				if (q <= 1) {
+					vr_zeros = true;
+					if (accept_bounds) vm_zeros = mm_shift == 1;
+					else vp--;
+				}
+				else if (q < 31) vr_zeros = multiple_of_pow2(mv, q - 1);
+			}
+			int removed = 0;
+			if (vm_zeros || vr_zeros) {
+				while (vp / 10 > vm / 10) {
+					vm_zeros &= vm % 10 == 0;
+					vr_zeros &= last == 0;
+					last = vr % 10;
+					vr /= 10; vp /= 10; vm /= 10;
+					removed++;
+				}
+				if (vm_zeros) {
+					while (vm % 10 == 0) {
+						vr_zeros &= last == 0;
+						last = vr % 10;
+						vr /= 10; vp /= 10; vm /= 10;
+						removed++;
+					}
+				}
+				if (vr_zeros && last == 5 && vr % 2 == 0) last = 4;
+				digits = vr + (((vr == vm && (!accept_bounds || !vm_zeros)) || last >= 5) ? 1 : 0);
+			}
+			else {
+				while (vp / 10 > vm / 10) {
+					last = vr % 10;
+					vr /= 10; vp /= 10; vm /= 10;
+					removed++;
+				}
+				digits = vr + ((vr == vm || last >= 5) ? 1 : 0);
+			}
+			exponent = e10 + removed;
 		}
+
 		/*
-		*** string_base<T> &append(const string_base<T> &)
-		*** appends str's value to this string
-		*** allocates much more memory if needed
-		*** does nothing if 
-			-> str's length == 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimization, using memcpy() now
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*** writes the integer m * 2^e (e >= 0, below 10^40) exactly, returns the length
+		*** doubles a little endian decimal number "e" times
 		*/
-		string_base<T> &append(const string_base<T> &str) {
-			if (!str.len) return (*this);
-			if (this == &str) {
-				append(string_base<T>(str));
-				return (*this);
-			}
-			unsigned o = len, l = str.len;
-			if (cap <= (len += l)) {
-				cap += (l + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
+		template <typename T>
+		unsigned write_exact(T *out, _ull_ m, int e) {
+			unsigned char d[40];
+			unsigned nd = 0;
+			do { d[nd++] = (unsigned char)(m % 10); m /= 10; } while (m);
+			for (; e > 0; e--) {
+				unsigned carry = 0;
+				for (unsigned i = 0; i < nd; i++) {
+					unsigned v = d[i] * 2U + carry;
+					d[i] = (unsigned char)(v % 10);
+					carry = v / 10;
+				}
+				if (carry) d[nd++] = (unsigned char)carry;
 			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
-#endif
-			memcpy(raw_data + o, str.raw_data, (len - o) * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
+			for (unsigned i = 0; i < nd; i++) out[i] = T('0' + d[nd - 1 - i]);
+			return nd;
 		}
-#ifdef STR_USE_BINDINGS
+
 		/*
-		*** string_base<T> &append(const std_string &)
-		*** appends str's value to this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> str's length == 0
-		*** returns (eventually modified) *this object
-		*** Added with Version 1.4
+		*** writes "digits" * 10^exponent, fixed if that isn't longer than
+		the scientific form (like std::to_chars()), returns the length
+		*** "m" * 2^"e2" is the exact binary value, fixed integers with 
+		exponent > 0 are written from it (like std::to_chars(), the shortest 
+		digits padded with '0' are another value once e2 > 0)
 		*/
-		string_base<T> &append(const std_string &str) {
-			return append(str.c_str());
+		template <typename T, typename U>
+		unsigned write_decimal(T *out, U digits, int exponent, _ull_ m, int e2) {
+			int n = (int)count_digits(digits), sci = exponent + n - 1;
+			int asci = (sci < 0) ? -sci : sci;
+			int sci_len = n + (n > 1) + 2 + ((asci >= 100) ? 3 : 2);
+			int fix_len = (exponent >= 0) ? (n + exponent) : ((sci >= 0) ? (n + 1) : (n + 1 - sci));
+			if (fix_len <= sci_len) {
+				if (exponent > 0 && e2 > 0) return write_exact(out, m, e2);
+				if (exponent >= 0) {
+					write_uint(out + n, digits);
+					for (int i = 0; i < exponent; i++) out[n + i] = T('0');
+				}
+				else if (sci >= 0) {
+					write_uint(out + n + 1, digits);
+					for (int i = 0; i <= sci; i++) out[i] = out[i + 1];
+					out[sci + 1] = T('.');
+				}
+				else {
+					out[0] = T('0');
+					out[1] = T('.');
+					for (int i = 2; i < 1 - sci; i++) out[i] = T('0');
+					write_uint(out + fix_len, digits);
+				}
+				return (unsigned)fix_len;
+			}
+			write_uint(out + n + 1, digits);
+			out[0] = out[1];
+			unsigned i = 1;
+			if (n > 1) { out[1] = T('.'); i = (unsigned)n + 1; }
+			out[i++] = T('e');
+			out[i++] = T((sci < 0) ? '-' : '+');
+			if (asci >= 100) { out[i++] = T('0' + asci / 100); asci %= 100; }
+			out[i++] = T(digit_pairs()[asci * 2]);
+			out[i++] = T(digit_pairs()[asci * 2 + 1]);
+			return i;
+		}
+
+		/* writes sign, "inf", "nan" or 0, returns the length or ~0U for other finite values */
+		template <typename T>
+		unsigned write_special(T *&out, bool neg, bool all_ones, bool zero, bool mantissa_zero) {
+			unsigned n = 0;
+			if (neg) { *out++ = T('-'); n = 1; }
+			if (all_ones && !mantissa_zero) { out[0] = T('n'); out[1] = T('a'); out[2] = T('n'); return n + 3; }
+			if (all_ones) { out[0] = T('i'); out[1] = T('n'); out[2] = T('f'); return n + 3; }
+			if (zero) { out[0] = T('0'); return n + 1; }
+			return ~0U;
+		}
+
+		/* shortest round-trip text of "value" (at most 24 chars, not terminated), returns the length */
+		template <typename T>
+		unsigned format_float(T *out, double value) {
+			_ull_ b;
+			memcpy(&b, &value, sizeof(b));
+			_ull_ mantissa = b & (((_ull_)1 << 52) - 1);
+			unsigned exponent = (unsigned)(b >> 52) & 0x7FF;
+			unsigned n = write_special(out, (b >> 63) != 0, exponent == 0x7FF, !exponent && !mantissa, !mantissa);
+			if (n != ~0U) return n;
+			_ull_ digits;
+			int e10;
+			shortest(mantissa, exponent, digits, e10);
+			_ull_ m = exponent ? (mantissa | ((_ull_)1 << 52)) : mantissa;
+			return (unsigned)(b >> 63) + write_decimal(out, digits, e10, m, (int)(exponent ? exponent : 1) - 1075);
+		}
+		template <typename T>
+		unsigned format_float(T *out, float value) {
+			unsigned b;
+			memcpy(&b, &value, sizeof(b));
+			unsigned mantissa = b & ((1U << 23) - 1), exponent = (b >> 23) & 0xFF;
+			unsigned n = write_special(out, (b >> 31) != 0, exponent == 0xFF, !exponent && !mantissa, !mantissa);
+			if (n != ~0U) return n;
+			unsigned digits;
+			int e10;
+			shortest(mantissa, exponent, digits, e10);
+			unsigned m = exponent ? (mantissa | (1U << 23)) : mantissa;
+			return (b >> 31) + write_decimal(out, digits, e10, m, (int)(exponent ? exponent : 1) - 150);
+		}
+	} /* namespace "numeric" */
+
+	/*
+	*** parse_result parse_number(const T *, unsigned, N &, unsigned)
+	*** converts the number at the beginning of the "n" chars at "s" (see above)
+	to "value" (any integer type, float, double or long double)
+	*** "base" is used for integers only
+	*** returns the position behind the number, or the position of the error
+	*** on parse_invalid "value" is unchanged; on parse_range integers are
+	unchanged while floating point values are set to +-infinity (overflow) or
+	+-0 (underflow, a non-zero number rounds to zero), like strtod()
+	*** Added with Version 1.9
+	*/
+	template <typename T, typename N>
+	inline parse_result parse_number(const T *s, unsigned n, N &value, unsigned base = 10U) { return numeric::parse_int(s, n, value, base); }
+	template <typename T>
+	inline parse_result parse_number(const T *s, unsigned n, float &value, unsigned = 10U) { return numeric::parse_float(s, n, value); }
+	template <typename T>
+	inline parse_result parse_number(const T *s, unsigned n, double &value, unsigned = 10U) { return numeric::parse_float(s, n, value); }
+	template <typename T>
+	inline parse_result parse_number(const T *s, unsigned n, _ld_ &value, unsigned = 10U) { return numeric::parse_float(s, n, value); }
+
+	/*
+	*********************************************************************
+	*** Unicode transcoding											  ***
+	*********************************************************************
+	*** validated conversions between UTF-8, UTF-16 and UTF-32; the encoding 
+	follows from the size of the char type: 1-byte chars hold UTF-8, 2-byte 
+	chars UTF-16 and 4-byte chars UTF-32 (wchar_t is UTF-16 on Windows and 
+	UTF-32 elsewhere)
+	*** two passes: utf_length() validates the source and counts the code 
+	units of the result, utf_convert() writes them, so the destination is 
+	allocated exactly once
+	*** SIMD (see STR_NO_SIMD): ASCII blocks are validated, counted and 
+	widened or narrowed 16 bytes at a time; UTF-16 blocks without surrogates 
+	and UTF-32 blocks are validated and counted as a whole and converted 
+	between each other if no surrogate pair is involved; UTF-8 is validated 
+	by nibble lookups (SSSE3, Keiser and Lemire, 2021); all other sequences 
+	are decoded and encoded one code point at a time
+	*** invalid: stray continuation bytes, overlong forms, surrogates in UTF-8 
+	and UTF-32, unpaired surrogates in UTF-16, code points above U+10FFFF and 
+	sequences cut off by the end of the source
+	*** Added with Version 1.9
+	*/
+	enum utf_error {
+		utf_ok = 0,			/* the source is valid */
+		utf_invalid,		/* invalid code unit or sequence */
+		utf_truncated		/* the source ends within a sequence (which may go on in the next chunk of a stream) */
+	};
+	struct utf_result {
+		unsigned pos;		/* position of the first code unit of the invalid sequence, or the source's length */
+		unsigned length;	/* number of code units of the result (0 on error) */
+		utf_error error;	/* utf_ok on success */
+		bool ok() const { return error == utf_ok; }
+	};
+
+	namespace utf {
+		/* code units the scanned code points need in each encoding */
+		struct sizes {
+			unsigned u8, u16, u32;
+			unsigned of(simd::width<1>) const { return u8; }
+			unsigned of(simd::width<2>) const { return u16; }
+			unsigned of(simd::width<4>) const { return u32; }
+		};
+		inline utf_result result(unsigned pos, utf_error error) {
+			utf_result r;
+			r.pos = pos;
+			r.length = 0;
+			r.error = error;
+			return r;
+		}
+#ifdef STR_SSE2
+		/* sum of the 32 bit lanes of "v" (or of its two 64 bit lanes if they are below 2^32) */
+		inline unsigned hsum(__m128i v) {
+			v = _mm_add_epi32(v, _mm_srli_si128(v, 8));
+			v = _mm_add_epi32(v, _mm_srli_si128(v, 4));
+			return (unsigned)_mm_cvtsi128_si32(v);
 		}
 #endif
+
 		/*
-		*** string_base<T> &append(const T *, unsigned)
-		*** appends the first "count" characters of c_str's value to this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> first character of "c_str" == 0x00
-			-> count == 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimization, using memcpy() now
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*** unsigned check(const T *, unsigned, unsigned &, utf_error &, width<N>)
+		*** decodes the sequence at the beginning of the "n" (> 0) code units at "s" to "cp"
+		*** returns its length, or 0 if it's invalid ("e" tells why)
 		*/
-		string_base<T> &append(const T *c_str, unsigned count) {
-			if (!*c_str || !count) return (*this);
-			unsigned ac_len = MIN(count, strlength<T>(c_str));
-			unsigned o = len;
-			if (cap <= (len += ac_len)) {
-				cap += (ac_len + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
+		template <typename T>
+		unsigned check(const T *s, unsigned n, unsigned &cp, utf_error &e, simd::width<1>) {
+			unsigned c = (unsigned char)s[0], lo = 0x80, hi = 0xBF, k, i;
+			if (c < 0x80) { cp = c; return 1; }
+			if (c < 0xC2 || c > 0xF4) { e = utf_invalid; return 0; }
+			if (c < 0xE0) { k = 2; cp = c & 0x1F; }
+			else if (c < 0xF0) { k = 3; cp = c & 0x0F; if (c == 0xE0) lo = 0xA0; else if (c == 0xED) hi = 0x9F; }
+			else { k = 4; cp = c & 0x07; if (c == 0xF0) lo = 0x90; else if (c == 0xF4) hi = 0x8F; }
+			/* the second byte excludes overlong forms, surrogates and code points above U+10FFFF */
+			for (i = 1; i < k; ++i, lo = 0x80, hi = 0xBF) {
+				if (i >= n) { e = utf_truncated; return 0; }
+				unsigned b = (unsigned char)s[i];
+				if (b < lo || b > hi) { e = utf_invalid; return 0; }
+				cp = (cp << 6) | (b & 0x3F);
 			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
-#endif
-			memcpy(raw_data + o, c_str, ac_len * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
+			return k;
 		}
-		/*
-		*** string_base<T> &append(const T *, unsigned, unsigned)
-		*** appends a substring of "c_str" (starting at position 
-		"start" with a length of "count") to this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> substring's length ("count") == 0
-			-> first character of c_str's value == 0x00
-		*** if "start" is greater than c_str's length, then start = 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimization, using memcpy() now
-		*** Version 1.6: Added assertions to make debugging the program easier
+		template <typename T>
+		unsigned check(const T *s, unsigned n, unsigned &cp, utf_error &e, simd::width<2>) {
+			unsigned c = (unsigned)s[0] & 0xFFFF, d;
+			if (c - 0xD800 >= 0x800) { cp = c; return 1; }
+			if (c >= 0xDC00) { e = utf_invalid; return 0; }
+			if (n < 2) { e = utf_truncated; return 0; }
+			d = (unsigned)s[1] & 0xFFFF;
+			if (d - 0xDC00 >= 0x400) { e = utf_invalid; return 0; }
+			cp = 0x10000 + ((c - 0xD800) << 10) + (d - 0xDC00);
+			return 2;
+		}
+		template <typename T>
+		unsigned check(const T *s, unsigned, unsigned &cp, utf_error &e, simd::width<4>) {
+			cp = (unsigned)s[0];
+			if (cp > 0x10FFFF || cp - 0xD800 < 0x800) { e = utf_invalid; return 0; }
+			return 1;
+		}
+
+		/* decodes the valid sequence at "s" to "cp", returns its length */
+		template <typename T>
+		inline unsigned decode(const T *s, unsigned &cp, simd::width<1>) {
+			unsigned c = (unsigned char)s[0];
+			if (c < 0x80) { cp = c; return 1; }
+			if (c < 0xE0) { cp = ((c & 0x1F) << 6) | (s[1] & 0x3F); return 2; }
+			if (c < 0xF0) { cp = ((c & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F); return 3; }
+			cp = ((c & 0x07) << 18) | ((s[1] & 0x3F) << 12) | ((s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+			return 4;
+		}
+		template <typename T>
+		inline unsigned decode(const T *s, unsigned &cp, simd::width<2>) {
+			unsigned c = (unsigned)s[0] & 0xFFFF;
+			if (c - 0xD800 >= 0x800) { cp = c; return 1; }
+			cp = 0x10000 + ((c - 0xD800) << 10) + (((unsigned)s[1] & 0xFFFF) - 0xDC00);
+			return 2;
+		}
+		template <typename T>
+		inline unsigned decode(const T *s, unsigned &cp, simd::width<4>) { cp = (unsigned)s[0]; return 1; }
+		/* encodes the code point "cp" to "o", returns the number of code units written */
+		template <typename T>
+		inline unsigned encode(unsigned cp, T *o, simd::width<1>) {
+			if (cp < 0x80) { o[0] = T(cp); return 1; }
+			if (cp < 0x800) { o[0] = T(0xC0 | (cp >> 6)); o[1] = T(0x80 | (cp & 0x3F)); return 2; }
+			if (cp < 0x10000) { o[0] = T(0xE0 | (cp >> 12)); o[1] = T(0x80 | ((cp >> 6) & 0x3F)); o[2] = T(0x80 | (cp & 0x3F)); return 3; }
+			o[0] = T(0xF0 | (cp >> 18)); o[1] = T(0x80 | ((cp >> 12) & 0x3F)); o[2] = T(0x80 | ((cp >> 6) & 0x3F)); o[3] = T(0x80 | (cp & 0x3F));
+			return 4;
+		}
+		template <typename T>
+		inline unsigned encode(unsigned cp, T *o, simd::width<2>) {
+			if (cp < 0x10000) { o[0] = T(cp); return 1; }
+			o[0] = T(0xD800 + ((cp - 0x10000) >> 10));
+			o[1] = T(0xDC00 + (cp & 0x3FF));
+			return 2;
+		}
+		template <typename T>
+		inline unsigned encode(unsigned cp, T *o, simd::width<4>) { o[0] = T(cp); return 1; }
+
+		/*
+		*** utf_result scan(const T *, unsigned, sizes &, width<N>)
+		*** validates the "n" code units at "s" and counts the code units of each 
+		encoding they convert to ("z" is only set if they are valid)
+		*** vector blocks which can't be handled at once are checked one code 
+		point at a time up to the end of the block
 		*/
-		string_base<T> &append(const T *c_str, unsigned start, unsigned count) {
-			if (!count || !*c_str) return (*this);
-			unsigned o = len;
-			unsigned l = strlength<T>(c_str);
-			if (start > l) start = 0;
-			if ((start + count) > l) 
-				count = (l - start);
-			if (cap <= (len += count)) {
-				cap += (count + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
+		template <typename T>
+		utf_result scan(const T *s, unsigned n, sizes &z, simd::width<1>) {
+			unsigned i = 0, cp, points = 0, four = 0;
+#ifdef STR_SSSE3
+			/*
+			*** each byte is checked against the one to three bytes before it: the 
+			high and low nibble of the previous byte and the high nibble of the 
+			current one select bit sets of the errors they allow, any bit set in 
+			all three is an error (too short, too long, overlong, surrogate, too 
+			large, two continuations); the third and fourth byte of a sequence 
+			must be continuations exactly where the lead two or three bytes back 
+			asks for them
+			*/
+			{
+				const char too_short = 1, too_long = 2, overlong_3 = 4, too_large = 8, surrogate = 16, overlong_2 = 32, 
+					too_large_1000 = 64, overlong_4 = 64, two_conts = (char)128, carry = too_short | too_long | two_conts;
+				const __m128i high1 = _mm_setr_epi8(too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long, 
+					two_conts, two_conts, two_conts, two_conts, too_short | overlong_2, too_short, too_short | overlong_3 | surrogate, 
+					too_short | too_large | too_large_1000 | overlong_4);
+				const __m128i low1 = _mm_setr_epi8(carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2, carry, carry, 
+					carry | too_large, carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000, 
+					carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000, 
+					carry | too_large | too_large_1000, carry | too_large | too_large_1000 | surrogate, carry | too_large | too_large_1000, carry | too_large | too_large_1000);
+				const __m128i high2 = _mm_setr_epi8(too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short, 
+					too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4, too_long | overlong_2 | two_conts | overlong_3 | too_large, 
+					too_long | overlong_2 | two_conts | surrogate | too_large, too_long | overlong_2 | two_conts | surrogate | too_large, 
+					too_short, too_short, too_short, too_short);
+				/* leads in the last three bytes of a block which the block can't complete */
+				const __m128i limit = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)0xEF, (char)0xDF, (char)0xBF);
+				const __m128i nibble = _mm_set1_epi8(0x0F), one = _mm_set1_epi8(1), zero = _mm_setzero_si128();
+				__m128i prev = zero, leads = zero, fours = zero;
+				bool open = false;	/* the previous block ends within a sequence */
+				for (; i + 16 <= n; i += 16) {
+					__m128i in = _mm_loadu_si128((const __m128i *)(s + i));
+					if (!_mm_movemask_epi8(in)) {
+						/* ASCII: only a sequence left open by the previous block is an error */
+						if (open) break;
+						prev = zero;
+						points += 16;
+						continue;
+					}
+					__m128i p1 = _mm_alignr_epi8(in, prev, 15), p2 = _mm_alignr_epi8(in, prev, 14), p3 = _mm_alignr_epi8(in, prev, 13);
+					__m128i err = _mm_and_si128(_mm_and_si128(_mm_shuffle_epi8(high1, _mm_and_si128(_mm_srli_epi16(p1, 4), nibble)), 
+						_mm_shuffle_epi8(low1, _mm_and_si128(p1, nibble))), _mm_shuffle_epi8(high2, _mm_and_si128(_mm_srli_epi16(in, 4), nibble)));
+					__m128i must23 = _mm_or_si128(_mm_subs_epu8(p2, _mm_set1_epi8((char)(0xE0 - 0x80))), _mm_subs_epu8(p3, _mm_set1_epi8((char)(0xF0 - 0x80))));
+					err = _mm_xor_si128(_mm_and_si128(must23, _mm_set1_epi8((char)0x80)), err);
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(err, zero)) != 0xFFFF) break;	/* located by the scalar loop below */
+					open = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(in, limit), zero)) != 0xFFFF;
+					prev = in;
+					/* code points start at every byte but continuations, four byte ones need a surrogate pair */
+					leads = _mm_add_epi64(leads, _mm_sad_epu8(_mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8(-65)), one), zero));
+					fours = _mm_add_epi64(fours, _mm_sad_epu8(_mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(in, _mm_set1_epi8((char)0xF0)), in), one), zero));
+				}
+				points += hsum(leads);
+				four += hsum(fours);
+				/* go on at the lead of a sequence which may run into position i */
+				for (unsigned j = 1; j <= 3 && j <= i; ++j) {
+					unsigned c = (unsigned char)s[i - j];
+					if ((c & 0xC0) == 0x80) continue;
+					if (c >= 0xC0) {
+						i -= j;
+						--points;
+						four -= (c >= 0xF0);
+					}
+					break;
+				}
 			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
 #endif
-			memcpy(raw_data, c_str + start, count * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
+			while (i < n) {
+#ifdef STR_SSE2
+				if (i + 16 <= n && !_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(s + i)))) {
+					points += 16;
+					i += 16;
+					continue;
+				}
+#endif
+				for (unsigned end = MIN(i + 16, n); i < end; ++points) {
+					utf_error e;
+					unsigned k = check(s + i, n - i, cp, e, simd::width<1>());
+					if (!k) return result(i, e);
+					four += (k == 4);
+					i += k;
+				}
+			}
+			z.u8 = n;
+			z.u16 = points + four;
+			z.u32 = points;
+			return result(n, utf_ok);
 		}
-		/*
-		*** string_base<T> &append(const string_base<T> &, unsigned, unsigned)
-		*** appends a substring of "str" (starting at position "start" with a 
-		length of "count") to this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> substring's length ("count") == 0
-			-> str's length == 0
-		*** if "start" is greater than str's length, then start = 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimization, using memcpy() now
-		*** Version 1.6: Added assertions to make debugging the program easier
-		*/
-		string_base<T> &append(const string_base<T> &str, unsigned start, unsigned count) {
-			if (!count || !str.len) return (*this);
-			if (this == &str) {
-				append(string_base<T>(str), start, count);
-				return (*this);
+		template <typename T>
+		utf_result scan(const T *s, unsigned n, sizes &z, simd::width<2>) {
+			unsigned i = 0, cp, u8 = 0, pairs = 0;
+#ifdef STR_SSE2
+			__m128i below = _mm_setzero_si128();	/* minus the units below U+0080 and below U+0800 */
+#endif
+			while (i < n) {
+#ifdef STR_SSE2
+				if (i + 8 <= n) {
+					const __m128i v = _mm_loadu_si128((const __m128i *)(s + i)), zero = _mm_setzero_si128();
+					/* no surrogates: every unit is a code point below U+10000 */
+					if (!_mm_movemask_epi8(_mm_cmplt_epi16(_mm_add_epi16(v, _mm_set1_epi16((short)0xA800)), _mm_set1_epi16((short)0x8800)))) {
+						__m128i m = _mm_add_epi16(_mm_cmpeq_epi16(_mm_subs_epu16(v, _mm_set1_epi16(0x7F)), zero), _mm_cmpeq_epi16(_mm_subs_epu16(v, _mm_set1_epi16(0x7FF)), zero));
+						below = _mm_add_epi32(below, _mm_madd_epi16(m, _mm_set1_epi16(1)));
+						u8 += 24;
+						i += 8;
+						continue;
+					}
+				}
+#endif
+				for (unsigned end = MIN(i + 8, n); i < end; ) {
+					utf_error e;
+					unsigned k = check(s + i, n - i, cp, e, simd::width<2>());
+					if (!k) return result(i, e);
+					u8 += 1 + (cp >= 0x80) + (cp >= 0x800) + (cp >= 0x10000);
+					pairs += k - 1;
+					i += k;
+				}
 			}
-			unsigned o = len;
-			unsigned l = str.len;
-			if (start > l) start = 0;
-			if ((start + count) > l) 
-				count = (l - start);
-			if (cap <= (len += count)) {
-				cap += (count + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
+#ifdef STR_SSE2
+			u8 += hsum(below);
+#endif
+			z.u8 = u8;
+			z.u16 = n;
+			z.u32 = n - pairs;
+			return result(n, utf_ok);
+		}
+		template <typename T>
+		utf_result scan(const T *s, unsigned n, sizes &z, simd::width<4>) {
+			unsigned i = 0, cp, u8 = 0, u16 = 0;
+#ifdef STR_SSE2
+			__m128i above = _mm_setzero_si128(), pairs = _mm_setzero_si128();	/* minus the units above U+007F, U+07FF and U+FFFF */
+#endif
+			while (i < n) {
+#ifdef STR_SSE2
+				if (i + 4 <= n) {
+					const __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+					__m128i bad = _mm_or_si128(_mm_cmpgt_epi32(v, _mm_set1_epi32(0x10FFFF)), _mm_cmplt_epi32(v, _mm_setzero_si128()));
+					bad = _mm_or_si128(bad, _mm_cmplt_epi32(_mm_add_epi32(v, _mm_set1_epi32((int)(0x80000000U - 0xD800))), _mm_set1_epi32((int)(0x80000000U + 0x800))));
+					if (!_mm_movemask_epi8(bad)) {
+						__m128i p = _mm_cmpgt_epi32(v, _mm_set1_epi32(0xFFFF));
+						above = _mm_add_epi32(above, _mm_add_epi32(_mm_add_epi32(_mm_cmpgt_epi32(v, _mm_set1_epi32(0x7F)), _mm_cmpgt_epi32(v, _mm_set1_epi32(0x7FF))), p));
+						pairs = _mm_add_epi32(pairs, p);
+						u8 += 4;
+						u16 += 4;
+						i += 4;
+						continue;
+					}
+				}
+#endif
+				for (unsigned end = MIN(i + 4, n); i < end; ++i) {
+					utf_error e;
+					if (!check(s + i, n - i, cp, e, simd::width<4>())) return result(i, e);
+					u8 += 1 + (cp >= 0x80) + (cp >= 0x800) + (cp >= 0x10000);
+					u16 += 1 + (cp >= 0x10000);
+				}
 			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
+#ifdef STR_SSE2
+			u8 -= hsum(above);
+			u16 -= hsum(pairs);
 #endif
-			memcpy(raw_data, str.raw_data + start, count * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
+			z.u8 = u8;
+			z.u16 = u16;
+			z.u32 = n;
+			return result(n, utf_ok);
 		}
-#ifdef STR_USE_BINDINGS
+
 		/*
-		*** string_base<T> &append(const string_base<T> &, unsigned, unsigned)
-		*** appends a substring of "str" (starting at position "start" with a
-		length of "count") to this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> substring's length ("count") == 0
-			-> str's length == 0
-		*** if "start" is greater than str's length, then start = 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimization, using memcpy() now
+		*** unsigned convert(const S *, unsigned, D *, width<N>, width<M>)
+		*** converts the "n" valid code units at "s" to "o" (UTF-N to UTF-M by 
+		bytes), returns the number of code units written
 		*/
-		string_base<T> &append(const std_string &str, unsigned start, unsigned count) {
-			return append(str.c_str(), start, count);
+		template <typename S, typename D, unsigned N>
+		unsigned convert(const S *s, unsigned n, D *o, simd::width<N>, simd::width<N>) {
+			if (n) memcpy(o, s, n * sizeof(S));
+			return n;
 		}
+		template <typename S, typename D>
+		unsigned convert(const S *s, unsigned n, D *o, simd::width<1>, simd::width<2>) {
+			unsigned i = 0, w = 0, cp;
+			while (i < n) {
+#ifdef STR_SSE2
+				if (i + 16 <= n) {
+					const __m128i v = _mm_loadu_si128((const __m128i *)(s + i)), zero = _mm_setzero_si128();
+					if (!_mm_movemask_epi8(v)) {
+						_mm_storeu_si128((__m128i *)(o + w), _mm_unpacklo_epi8(v, zero));
+						_mm_storeu_si128((__m128i *)(o + w + 8), _mm_unpackhi_epi8(v, zero));
+						i += 16;
+						w += 16;
+						continue;
+					}
+				}
 #endif
-		/*
-		*** string_base<T> &insert(const string_base<T> &, unsigned)
-		*** insert str's value at position "pos" in this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> Given "pos" is greater than current value's length (this->length())
-			-> str's length == 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimizing, using memmove() and memcpy() now
-		*** Version 1.6: Added assertions to make debugging the program easier
-		*/
-		string_base<T> &insert(const string_base<T> &str, unsigned pos) {
-			if (pos > len || !str.len) return (*this);
-			if (this == &str) {
-				insert(string_base<T>(str), pos);
-				return (*this);
+				for (unsigned end = MIN(i + 16, n); i < end; )
+					i += decode(s + i, cp, simd::width<1>()), w += encode(cp, o + w, simd::width<2>());
 			}
-			if (cap <= (len += str.len)) {
-				cap += (str.len + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
+			return w;
+		}
+		template <typename S, typename D>
+		unsigned convert(const S *s, unsigned n, D *o, simd::width<1>, simd::width<4>) {
+			unsigned i = 0, w = 0;
+			while (i < n) {
+#ifdef STR_SSE2
+				if (i + 16 <= n) {
+					const __m128i v = _mm_loadu_si128((const __m128i *)(s + i)), zero = _mm_setzero_si128();
+					if (!_mm_movemask_epi8(v)) {
+						__m128i lo = _mm_unpacklo_epi8(v, zero), hi = _mm_unpackhi_epi8(v, zero);
+						_mm_storeu_si128((__m128i *)(o + w), _mm_unpacklo_epi16(lo, zero));
+						_mm_storeu_si128((__m128i *)(o + w + 4), _mm_unpackhi_epi16(lo, zero));
+						_mm_storeu_si128((__m128i *)(o + w + 8), _mm_unpacklo_epi16(hi, zero));
+						_mm_storeu_si128((__m128i *)(o + w + 12), _mm_unpackhi_epi16(hi, zero));
+						i += 16;
+						w += 16;
+						continue;
+					}
+				}
+#endif
+				for (unsigned end = MIN(i + 16, n), cp; i < end; ++w) {
+					i += decode(s + i, cp, simd::width<1>());
+					o[w] = D(cp);
+				}
 			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
+			return w;
+		}
+		template <typename S, typename D>
+		unsigned convert(const S *s, unsigned n, D *o, simd::width<2>, simd::width<1>) {
+			unsigned i = 0, w = 0, cp;
+			while (i < n) {
+#ifdef STR_SSE2
+				if (i + 8 <= n) {
+					const __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(v, _mm_set1_epi16(0x7F)), _mm_setzero_si128())) == 0xFFFF) {
+						_mm_storel_epi64((__m128i *)(o + w), _mm_packus_epi16(v, v));
+						i += 8;
+						w += 8;
+						continue;
+					}
+				}
 #endif
-			memmove(raw_data + (pos + str.len), raw_data + pos, (len - str.len - pos) * sizeof(T));
-			memcpy(raw_data + pos, str.raw_data, str.len * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
+				for (unsigned end = MIN(i + 8, n); i < end; )
+					i += decode(s + i, cp, simd::width<2>()), w += encode(cp, o + w, simd::width<1>());
+			}
+			return w;
 		}
-		/*
-		*** string_base<T> &insert(const string_base<T> &, unsigned, unsigned, unsigned)
-		*** inserts a substring of "str" (starting at position "start" with a length of 
-		"count") at position "pos" in this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> Given "pos" is greater than current value's length (this->length())
-			-> substring's length ("count") == 0
-		*** if "start" is greater than str's length, then start = 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimizing, using memmove() and memcpy() now
-		*** Version 1.6: Added assertions to make debugging the program easier
-		*/
-		string_base<T> &insert(const string_base<T> &str, unsigned pos, unsigned start, unsigned count) {
-			if (pos > len || !count) return (*this);
-			if (this == &str) {
-				insert(string_base<T>(str), pos, start, count);
-				return (*this);
+		template <typename S, typename D>
+		unsigned convert(const S *s, unsigned n, D *o, simd::width<2>, simd::width<4>) {
+			unsigned i = 0, w = 0;
+			while (i < n) {
+#ifdef STR_SSE2
+				if (i + 8 <= n) {
+					const __m128i v = _mm_loadu_si128((const __m128i *)(s + i)), zero = _mm_setzero_si128();
+					if (!_mm_movemask_epi8(_mm_cmplt_epi16(_mm_add_epi16(v, _mm_set1_epi16((short)0xA800)), _mm_set1_epi16((short)0x8800)))) {
+						_mm_storeu_si128((__m128i *)(o + w), _mm_unpacklo_epi16(v, zero));
+						_mm_storeu_si128((__m128i *)(o + w + 4), _mm_unpackhi_epi16(v, zero));
+						i += 8;
+						w += 8;
+						continue;
+					}
+				}
+#endif
+				for (unsigned end = MIN(i + 8, n), cp; i < end; ++w) {
+					i += decode(s + i, cp, simd::width<2>());
+					o[w] = D(cp);
+				}
 			}
-			unsigned l = str.len;
-			if (start > l) start = 0;
-			if ((start + count) > l) 
-				count = (l - start);
-			if (cap <= (len += count)) {
-				cap += (count + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
+			return w;
+		}
+		template <typename S, typename D>
+		unsigned convert(const S *s, unsigned n, D *o, simd::width<4>, simd::width<1>) {
+			unsigned i = 0, w = 0;
+#ifdef STR_SSE2
+			const __m128i ascii = _mm_set1_epi32(0x80);
+#endif
+			while (i < n) {
+#ifdef STR_SSE2
+				if (i + 8 <= n) {
+					const __m128i a = _mm_loadu_si128((const __m128i *)(s + i)), b = _mm_loadu_si128((const __m128i *)(s + i + 4));
+					if (_mm_movemask_epi8(_mm_and_si128(_mm_cmplt_epi32(a, ascii), _mm_cmplt_epi32(b, ascii))) == 0xFFFF) {
+						__m128i v = _mm_packs_epi32(a, b);
+						_mm_storel_epi64((__m128i *)(o + w), _mm_packus_epi16(v, v));
+						i += 8;
+						w += 8;
+						continue;
+					}
+				}
+#endif
+				for (unsigned end = MIN(i + 8, n); i < end; ++i)
+					w += encode((unsigned)s[i], o + w, simd::width<1>());
 			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
+			return w;
+		}
+		template <typename S, typename D>
+		unsigned convert(const S *s, unsigned n, D *o, simd::width<4>, simd::width<2>) {
+			unsigned i = 0, w = 0;
+#ifdef STR_SSE2
+			const __m128i bmp = _mm_set1_epi32(0x10000), bias = _mm_set1_epi32(0x8000);
 #endif
-			memmove(raw_data + (pos + count), raw_data + pos, (len - count - pos) * sizeof(T));
-			memcpy(raw_data + pos, str.raw_data + start, count * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
+			while (i < n) {
+#ifdef STR_SSE2
+				if (i + 8 <= n) {
+					const __m128i a = _mm_loadu_si128((const __m128i *)(s + i)), b = _mm_loadu_si128((const __m128i *)(s + i + 4));
+					if (_mm_movemask_epi8(_mm_and_si128(_mm_cmplt_epi32(a, bmp), _mm_cmplt_epi32(b, bmp))) == 0xFFFF) {
+						/* biased into the range of the signed saturating pack */
+						__m128i v = _mm_packs_epi32(_mm_sub_epi32(a, bias), _mm_sub_epi32(b, bias));
+						_mm_storeu_si128((__m128i *)(o + w), _mm_add_epi16(v, _mm_set1_epi16((short)0x8000)));
+						i += 8;
+						w += 8;
+						continue;
+					}
+				}
+#endif
+				for (unsigned end = MIN(i + 8, n); i < end; ++i)
+					w += encode((unsigned)s[i], o + w, simd::width<2>());
+			}
+			return w;
 		}
-#ifdef STR_USE_BINDINGS
+	} /* namespace "utf" */
+
+	/*
+	*** utf_result utf_length(const S *, unsigned)
+	*** validates the "n" code units at "s" (UTF-8, UTF-16 or UTF-32 by 
+	sizeof(S)) and returns the number of code units of D they convert to
+	(utf_length<char16_t>(s, n).length)
+	*** on error the result holds the position and kind of the first invalid sequence
+	*** Added with Version 1.9
+	*/
+	template <typename D, typename S>
+	inline utf_result utf_length(const S *s, unsigned n) {
+		utf::sizes z;
+		utf_result r = utf::scan(s, n, z, simd::width<sizeof(S)>());
+		if (r.ok()) r.length = z.of(simd::width<sizeof(D)>());
+		return r;
+	}
+	/*
+	*** utf_result utf_validate(const T *, unsigned)
+	*** checks whether the "n" code units at "s" are valid UTF-8, UTF-16 or UTF-32 (by sizeof(T))
+	*** Added with Version 1.9
+	*/
+	template <typename T>
+	inline utf_result utf_validate(const T *s, unsigned n) { return utf_length<T>(s, n); }
+	/*
+	*** unsigned utf_convert(const S *, unsigned, D *)
+	*** converts the "n" code units at "s" to the encoding of D and writes them 
+	to "out" (no null-terminator), returns the number of code units written
+	*** the source has to be valid and "out" has to hold utf_length<D>(s, n).length code units
+	*** Added with Version 1.9
+	*/
+	template <typename D, typename S>
+	inline unsigned utf_convert(const S *s, unsigned n, D *out) { return utf::convert(s, n, out, simd::width<sizeof(S)>(), simd::width<sizeof(D)>()); }
+
+#ifdef STR_USE_COW
+	/*
+	*********************************************************************
+	*** atomic reference counts (see STR_USE_COW)					  ***
+	*********************************************************************
+	*** increment() may be relaxed (the caller already owns a reference), 
+	decrement() orders all prior accesses before the buffer is freed
+	*** Added with Version 1.9
+	*/
+	namespace atomic {
+	#if defined(__GNUC__)
+		inline void increment(volatile long *p) { __atomic_add_fetch(p, 1L, __ATOMIC_RELAXED); }
+		inline long decrement(volatile long *p) { return __atomic_sub_fetch(p, 1L, __ATOMIC_ACQ_REL); }
+		inline long load(volatile long *p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+	#elif defined(_MSC_VER)
+		inline void increment(volatile long *p) { _InterlockedIncrement(p); }
+		inline long decrement(volatile long *p) { return _InterlockedDecrement(p); }
+		inline long load(volatile long *p) { return _InterlockedCompareExchange(p, 0L, 0L); }
+	#else
+		#error "STR_USE_COW needs the atomic builtins of GCC, Clang or MSVC"
+	#endif
+	}; /* namespace "atomic" */
+#endif
+
+	/*
+	*********************************************************************
+	*** growth policies												  ***
+	*********************************************************************
+	*** a growth policy decides how much memory string_base<T> 
+	allocates once its buffer is too small
+	*** it has to provide one static function:
+		unsigned grow(unsigned cap, unsigned count, unsigned size)
+	*** "cap" is the current capacity, "count" the number of chars 
+	(null-terminator included) needed and "size" equals sizeof(T)
+	*** returns the new capacity in chars, which has to be >= "count"
+	*** Added with Version 1.9
+	*/
+
+	/*
+	*** growth_geometric<Num, Den>
+	*** multiplies the capacity by (Num / Den) [def: 1.5], but allocates at least STR_DEFSTRCAP chars
+	*** amortized O(1) copies per appended char (every char is copied 
+	at most Den / (Num - Den) times on average, 2 times for 1.5, once for 2)
+	*** wastes at most (Num / Den - 1) of the used memory (50% for 1.5)
+	*/
+	template <unsigned Num = 3, unsigned Den = 2>
+	struct growth_geometric {
+		static unsigned grow(unsigned cap, unsigned count, unsigned) {
+			unsigned res = cap / Den * Num + cap % Den * Num / Den;
+			if (res < cap) res = count; /* overflow */
+			if (res < STR_DEFSTRCAP) res = STR_DEFSTRCAP;
+			return MAX(res, count);
+		}
+	};
+
+	/*
+	*** growth_fixed<Step>
+	*** allocates "Step" chars more than needed [def: STR_ALLOC]
+	*** was the only strategy up to version 1.8
+	*** wastes at most "Step" chars per string, but appending n chars one 
+	by one costs O(n * n / Step) copies (linear growth)
+	*/
+	template <unsigned Step = STR_ALLOC>
+	struct growth_fixed {
+		static unsigned grow(unsigned, unsigned count, unsigned) {
+			return count + Step;
+		}
+	};
+
+	/*
+	*** growth_page<Page, Num, Den>
+	*** grows geometrically like growth_geometric<Num, Den>, but once the buffer 
+	reaches "Page" bytes [def: 4096] its size is rounded up to a multiple of "Page"
+	*** keeps large buffers page-aligned in size, so the allocator can hand out 
+	whole pages (and the slack at the end of the last page is used too)
+	*** same amortized guarantee as growth_geometric<Num, Den>, wastes 
+	at most (Num / Den - 1) of the used memory plus one page
+	*/
+	template <unsigned Page = 4096, unsigned Num = 3, unsigned Den = 2>
+	struct growth_page {
+		static unsigned grow(unsigned cap, unsigned count, unsigned size) {
+			unsigned res = growth_geometric<Num, Den>::grow(cap, count, size);
+			if (res * size < Page) return res;
+			return ((res * size + Page - 1) / Page * Page) / size;
+		}
+	};
+
+	/*
+	*********************************************************************
+	*** allocators													  ***
+	*********************************************************************
+	*** string_base<T> gets all of its heap memory from an allocator
+	*** an allocator has to provide (like std::allocator<T>):
+		T *allocate(unsigned count)
+		void deallocate(T *ptr, unsigned count)
+	*** it may be stateful, string_base<T> keeps a copy of it (copies take 
+	it over, moved and swapped strings exchange it as well)
+	*** with STR_USE_COW it has to provide operator == as well (buffers are 
+	only shared between strings whose allocators compare equal)
+	*** Added with Version 1.9
+	*/
+
+	/*
+	*** allocator<T>
+	*** default allocator of string_base<T>, 
+	uses malloc(), realloc() and free()
+	*/
+	template <typename T>
+	struct allocator {
+		typedef T value_type;	/* type of the allocated elements */
+
+		allocator() {}
+		template <typename U>
+		allocator(const allocator<U> &) {}
+
+		T *allocate(unsigned count) { return (T *)malloc(count * sizeof(T)); }							/* allocate "count" elements */
+		void deallocate(T *ptr, unsigned) { free(ptr); }												/* free memory returned by allocate() */
+		T *reallocate(T *ptr, unsigned count) { return (T *)realloc(ptr, count * sizeof(T)); }			/* resize memory returned by allocate() */
+
+		bool operator ==(const allocator &) const { return true; }		/* stateless, all instances are equal */
+		bool operator !=(const allocator &) const { return false; }		/* stateless, all instances are equal */
+	};
+
+	/*
+	*** alloc_traits<Alloc>
+	*** the only way string_base<T> accesses its allocator
+	*** reallocate() moves the first "used" elements of a buffer with a 
+	capacity of "old" into a new one with a capacity of "count" and frees the old one
+	*** the generic version allocates, copies and deallocates; specialize 
+	it to grow buffers in place (see str::allocator<T> below)
+	*/
+	template <typename Alloc>
+	struct alloc_traits {
+		typedef typename Alloc::value_type value_type;	/* type of the allocated elements */
+
+		static value_type *allocate(Alloc &a, unsigned count) { return a.allocate(count); }
+		static void deallocate(Alloc &a, value_type *ptr, unsigned count) { a.deallocate(ptr, count); }
+		static value_type *reallocate(Alloc &a, value_type *ptr, unsigned old, unsigned used, unsigned count) {
+			value_type *res = a.allocate(count);
+			if (!res) return res;
+			memcpy(res, ptr, MIN(used, count) * sizeof(value_type));
+			a.deallocate(ptr, old);
+			return res;
+		}
+	};
+
+	/* alloc_traits<allocator<T>>, uses realloc() which may grow the buffer in place */
+	template <typename T>
+	struct alloc_traits<allocator<T> > {
+		typedef T value_type;	/* type of the allocated elements */
+
+		static T *allocate(allocator<T> &a, unsigned count) { return a.allocate(count); }
+		static void deallocate(allocator<T> &a, T *ptr, unsigned count) { a.deallocate(ptr, count); }
+		static T *reallocate(allocator<T> &a, T *ptr, unsigned, unsigned, unsigned count) { return a.reallocate(ptr, count); }
+	};
+
+	/*
+	*** CLASS arena
+	*** monotonic (bump-pointer) memory arena for short-living strings
+	*** memory is taken from chunks of STR_ARENACHUNK bytes, an allocation 
+	is just a pointer increment
+	*** deallocate() only gives memory back if it was the most recent allocation, 
+	everything else is freed at once by reset() or the destructor
+	*** extend() grows the most recent allocation in place (used by arena_allocator<T>
+	to append to the last string allocated from the arena without copying)
+	*** not thread-safe, use one arena per thread (or per request)
+	*** strings using the arena have to be destroyed before reset() or the destructor is called
+	*** Added with Version 1.9
+	*/
+	class arena {
+	public:
+		/* create an empty arena, no memory is allocated before the first allocate() call */
+		explicit arena(unsigned chunk_size = STR_ARENACHUNK)
+			: head(NULL), top(NULL), limit(NULL), chunk_size(chunk_size), used_bytes(0) {}
+		/* free all chunks */
+		~arena() { release(); }
+
 		/*
-		*** string_base<T> &insert(const std_string &, unsigned, unsigned, unsigned)
-		*** inserts a substring of "str" (starting at position "start" with a length of
-		"count") at position "pos" in this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> Given "pos" is greater than current value's length (this->length())
-			-> substring's length ("count") == 0
-		*** if "start" is greater than str's length, then start = 0
-		*** returns (eventually modified) *this object
-		*** Added with Version 1.4
+		*** void *allocate(unsigned, unsigned)
+		*** returns "size" bytes aligned to "align" (has to be a power of two)
+		*** allocates a new chunk if the current one is exhausted
+		*** returns NULL if the system is out of memory
 		*/
-		string_base<T> &insert(const std_string &str, unsigned pos, unsigned start, unsigned count) {
-			return insert(str.c_str(), pos, start, count);
+		void *allocate(unsigned size, unsigned align = sizeof(void *)) {
+			char *p = align_ptr(top, align);
+			/* aligning may step past the end of the chunk */
+			if (!head || p > limit || size > (unsigned)(limit - p)) {
+				if (!add_chunk(size + align, align)) return NULL;
+				p = align_ptr(top, align);
+			}
+			top = p + size;
+			used_bytes += size;
+			return p;
 		}
-#endif
 		/*
-		*** string_base<T> &insert(const string_base<T> &, unsigned, unsigned)
-		*** inserts the first "count" characters of str's value at position "pos" in this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> Given "pos" is greater than current value's length (this->length())
-			-> str's length == 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimizing, using memmove() and memcpy() now
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*** bool extend(void *, unsigned, unsigned)
+		*** resizes the allocation "ptr" (of "old_size" bytes) to "size" bytes in place
+		*** only works for the most recent allocation, if the current chunk has enough space left
+		*** returns true on success, false if "ptr" has to be moved
 		*/
-		string_base<T> &insert(const string_base<T> &str, unsigned pos, unsigned count) {
-			if (pos > len || !str.len)
-				return (*this);
-			if (this == &str) {
-				insert(string_base<T>(str), pos, count);
-				return (*this);
-			}
-			if (count > str.len)
-				count -= (count - str.len);
-			if (cap <= (len += count)) {
-				cap += (count + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
-			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
-#endif
-			memmove(raw_data + (pos + count), raw_data + pos, (len - count - pos) * sizeof(T));
-			memcpy(raw_data + pos, str.raw_data, count * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
+		bool extend(void *ptr, unsigned old_size, unsigned size) {
+			char *p = (char *)ptr;
+			if (!head || p + old_size != top || p > limit || size > (unsigned)(limit - p))
+				return false;
+			top = p + size;
+			used_bytes += size;
+			used_bytes -= old_size;
+			return true;
 		}
-#ifdef STR_USE_BINDINGS
 		/*
-		*** string_base<T> &insert(const std_string &, unsigned, unsigned)
-		*** inserts the first "count" characters of str's value at position "pos" in this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> Given "pos" is greater than current value's length (this->length())
-			-> str's length == 0
-		*** returns (eventually modified) *this object
-		*** Added with Version 1.4
+		*** void deallocate(void *, unsigned)
+		*** gives the memory back to the arena if "ptr" is the most recent allocation
+		*** does nothing otherwise (memory is freed on reset())
 		*/
-		string_base<T> &insert(const std_string &str, unsigned pos, unsigned count) {
-			return insert(str.c_str(), pos, count);
+		void deallocate(void *ptr, unsigned size) {
+			if ((char *)ptr + size != top) return;
+			top = (char *)ptr;
+			used_bytes -= size;
 		}
-#endif
 		/*
-		*** string_base<T> &insert(const T *, unsigned)
-		*** inserts c_str's value at position "pos" in this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> Given "pos" is greater than current value's length (this->length())
-			-> first character of c_str's value == 0x00
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimizing, using memmove() and memcpy() now
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*** void reset()
+		*** frees all allocations at once
+		*** keeps the most recent chunk to serve the next allocations, frees the others
 		*/
-		string_base<T> &insert(const T *c_str, unsigned pos) {
-			if (pos > len || !*c_str) return (*this);
-			unsigned l = strlength<T>(c_str);
-			if (cap <= (len += l)) {
-				cap += (l + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
+		void reset() {
+			if (!head) return;
+			chunk *c = head->next;
+			while (c) {
+				chunk *next = c->next;
+				free(c);
+				c = next;
 			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
-#endif
-			memmove(raw_data + (pos + l), raw_data + pos, (len - l - pos) * sizeof(T));
-			memcpy(raw_data + pos, c_str, l * sizeof(T));
-			raw_data[len] = 0x00;
-			return (*this);
+			head->next = NULL;
+			top = (char *)(head + 1);
+			used_bytes = 0;
 		}
-		/*
-		*** string_base<T> &insert(const T *, unsigned, unsigned, unsigned)
-		*** inserts a substring of "c_str" (starting at position "start" with a 
-		length of "count") at position "pos" in this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> Given "pos" is greater than current value's length (this->length())
-			-> substring's length ("count") == 0
-			-> first character of c_str's value == 0x00
-		*** if "start" is greater than str's length, then start = 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimizing, using memmove() and memcpy() now
-		*** Version 1.6: Added assertions to make debugging the program easier
-		*/
-		string_base<T> &insert(const T *c_str, unsigned pos, unsigned start, unsigned count) {
-			if (pos > len || !count || !*c_str) return (*this);
-			unsigned o = len;
-			unsigned l = strlength<T>(c_str);
-			if (start > count) start = 0;
-			if ((start + count) > l) 
-				count = (l - start);
-			if (cap <= (len += count)) {
-				cap += (count + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
+		/* free all chunks, the arena can be used again afterwards */
+		void release() {
+			while (head) {
+				chunk *next = head->next;
+				free(head);
+				head = next;
 			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
+			top = limit = NULL;
+			used_bytes = 0;
+		}
+		unsigned used() const { return used_bytes; } /* returns number of bytes currently handed out */
+
+	private:
+		/* chunk header, the usable memory follows directly after it */
+		struct chunk {
+			chunk *next;	/* previously used chunk */
+			unsigned size;	/* usable bytes behind the header */
+		};
+
+		chunk *head;			/* current chunk */
+		char *top, *limit;		/* next free byte / end of current chunk */
+		unsigned chunk_size;	/* default size of new chunks */
+		unsigned used_bytes;	/* bytes currently handed out */
+
+		/* arenas own their chunks, copying one makes no sense */
+		arena(const arena &);
+		arena &operator =(const arena &);
+
+		static char *align_ptr(char *p, unsigned align) {
+			return (char *)(((size_t)p + (align - 1)) & ~(size_t)(align - 1));
+		}
+		/* allocate a new chunk with at least "size" usable bytes (rounded up to "align") and make it the current one */
+		bool add_chunk(unsigned size, unsigned align) {
+			unsigned s = (MAX(size, chunk_size) + (align - 1)) & ~(align - 1);
+			chunk *c = (chunk *)malloc(sizeof(chunk) + s);
+			if (!c) return false;
+			c->next = head;
+			c->size = s;
+			head = c;
+			top = (char *)(c + 1);
+			limit = top + s;
+			return true;
+		}
+	};
+
+	/*
+	*** arena_allocator<T>
+	*** allocator for string_base<T> taking its memory from a str::arena
+	*** converts implicitly from arena &, so an arena can be passed to every constructor 
+	which takes an allocator (e.g. str::arena_string s("text", my_arena);)
+	*** falls back to malloc() and free() if no arena is set
+	*/
+	template <typename T>
+	struct arena_allocator {
+		typedef T value_type;	/* type of the allocated elements */
+
+		arena *owner;			/* arena memory is taken from (NULL = heap) */
+
+		arena_allocator() : owner(NULL) {}
+		arena_allocator(arena &a) : owner(&a) {}
+		template <typename U>
+		arena_allocator(const arena_allocator<U> &a) : owner(a.owner) {}
+
+		/* allocate "count" elements */
+		T *allocate(unsigned count) {
+			if (!owner) return (T *)malloc(count * sizeof(T));
+#ifdef STR_USE_COW
+			return (T *)owner->allocate(count * sizeof(T), MAX(sizeof(T), sizeof(long)));	/* reference count header */
+#else
+			return (T *)owner->allocate(count * sizeof(T), sizeof(T));
 #endif
-			memmove(raw_data + (pos + count), raw_data + pos, (len - count - pos) * sizeof(T));
-			memcpy(raw_data + pos, c_str + start, count * sizeof(T));
+		}
+		/* free memory returned by allocate() (deferred to arena::reset() most likely) */
+		void deallocate(T *ptr, unsigned count) {
+			if (!owner) free(ptr);
+			else owner->deallocate(ptr, count * sizeof(T));
+		}
+
+		bool operator ==(const arena_allocator &a) const { return owner == a.owner; }	/* equal if they share the arena */
+		bool operator !=(const arena_allocator &a) const { return owner != a.owner; }	/* equal if they share the arena */
+	};
+
+	/* alloc_traits<arena_allocator<T>>, grows the most recent allocation of the arena in place */
+	template <typename T>
+	struct alloc_traits<arena_allocator<T> > {
+		typedef T value_type;	/* type of the allocated elements */
+
+		static T *allocate(arena_allocator<T> &a, unsigned count) { return a.allocate(count); }
+		static void deallocate(arena_allocator<T> &a, T *ptr, unsigned count) { a.deallocate(ptr, count); }
+		static T *reallocate(arena_allocator<T> &a, T *ptr, unsigned old, unsigned used, unsigned count) {
+			if (!a.owner) return (T *)realloc(ptr, count * sizeof(T));
+			if (a.owner->extend(ptr, old * sizeof(T), count * sizeof(T))) return ptr;
+			T *res = a.allocate(count);
+			if (!res) return res;
+			memcpy(res, ptr, MIN(used, count) * sizeof(T));
+			a.deallocate(ptr, old);
+			return res;
+		}
+	};
+
+	/*
+	*** predicate for remove_any() and split_any(), true for the chars of a set
+	(lookup table for chars below 256, a filter on the low byte and a 
+	linear search for the others)
+	*** refers to the chars of the set, they have to outlive the predicate
+	*** Added with Version 1.9
+	*/
+	template <typename T>
+	struct char_set {
+		unsigned char map[256];
+		const T *wide;
+		unsigned n;
+
+		char_set(const T *set, unsigned l) : wide(set), n(l) {
+			memset(map, 0, sizeof(map));
+			for (unsigned i = 0; i < l; i++) map[code(set[i]) & 0xFF] |= (code(set[i]) < 256) ? 1 : 2;
+		}
+		static unsigned code(T c) { return (sizeof(T) == 1) ? ((unsigned)c & 0xFF) : (unsigned)c; }
+		bool operator ()(T c) const {
+			unsigned u = code(c);
+			if (u < 256) return (map[u] & 1) != 0;
+			if (!(map[u & 0xFF] & 2)) return false;
+			for (unsigned i = 0; i < n; i++) if (wide[i] == c) return true;
+			return false;
+		}
+	};
+
+	/* empty tokens in split() and split_any() (see splitter<T>) */
+	enum split_mode {
+		split_keep_empty,	/* "a,,b" -> "a", "", "b" */
+		split_skip_empty	/* "a,,b" -> "a", "b" */
+	};
+
+	template <typename T> class string_view_base;
+	template <typename T, typename L, typename R> class concat;
+	template <typename T> class splitter;
+
+	/* 
+	*** TEMPLATE CLASS string_base<T> 
+	*** Version 1.9: added "Alloc" (allocator) and "Growth" (growth policy) template parameters
+	*** Alloc is a private base class to take advantage of the empty base optimization
+	*/
+	template <typename T, typename Alloc = allocator<T>, typename Growth = STR_DEFGROWTH>
+	class string_base : private Alloc {
+	public:
+		typedef T *iterator;						/* normal iterator type */
+		typedef const T *const_iterator;			/* const iterator type */
+		typedef T &reference;						/* normal reference type */
+		typedef const T &const_reference;			/* const reference type */
+		typedef T value_type;						/* char type */
+		typedef Alloc allocator_type;				/* allocator type */
+#ifdef STR_USE_BINDINGS
+		typedef std::basic_string<T, 
+			std::char_traits<T>, 
+			std::allocator<T> > std_string;			/* std::string typedef */
+#endif
+		/*
+		*** string_base<T>()
+		*** standard contructor
+		*** uses the inline buffer (STR_SSOSIZE bytes) and sets the first char to 0x00
+		*** performs no heap allocation at all
+		*** is pretty much the standard allocation state
+		*** use reset() to restore these settings
+		*** Version 1.9: no longer allocates DEF_STRCAP spaces
+		*** Version 1.9: optionally takes the allocator to use
+		*/
+		explicit string_base(const Alloc &alloc = Alloc())
+			: Alloc(alloc), raw_data(sso_buf), len(0), cap(sso_cap) {
+			raw_data[0] = 0x00;
+		} 
+		/*
+		*** string_base<T>(unsigned)
+		*** constructor to allocate "capacity" spaces by default
+		*** stays in the inline buffer if "capacity" fits into it
+		*** sets first character to 0x00 (null-terminator)
+		*/
+		explicit string_base(unsigned capacity, const Alloc &alloc = Alloc())
+			: Alloc(alloc), len(0) {
+			init_buf(capacity);
+			raw_data[0] = 0x00;
+		}
+		/*
+		*** string_base<T>(const T &, unsigned)
+		*** fill constructor
+		*** fill the freshly allocated string 
+		with specified char "ch" ("count" times)
+		*** allocates ("count" + 1) places
+		*** sets last char to 0x00 to finish string
+		*/
+		string_base(const T &ch, unsigned count, const Alloc &alloc = Alloc())
+			: Alloc(alloc), len(count) {
+			init_buf(count + 1);
+			for (unsigned i = 0; i < count; i++)
+				raw_data[i] = ch;
 			raw_data[len] = 0x00;
-			return (*this);
 		}
 		/*
-		*** string_base<T> &insert(const T *, unsigned, unsigned)
-		*** inserts the first "count" chars of c_str's value at position "pos" in this string
-		*** allocates much more memory if needed
-		*** does nothing if 
-			-> Given "pos" is greater than current value's length (this->length())
-			-> substring's length ("count") == 0
-			-> first character of c_str's value == 0x00
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimizing, using memmove() and memcpy() now
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*** string_base<T>(const T *)
+		*** constructor to assign a C-String
+		*** copies "str" in current string
+		*** automatically inserts null-terminator at the end
 		*/
-		string_base<T> &insert(const T *c_str, unsigned pos, unsigned count) {
-			if (pos > len || !count || !*c_str)
-				return (*this);
-			unsigned l = strlength<T>(c_str);
-			if (count > l) count -= (count - l);
-			if (cap <= (len += count)) {
-				cap += (count + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
-			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
+		string_base(const T *c_str, const Alloc &alloc = Alloc())
+			: Alloc(alloc), len(strlength<T>(c_str)) {
+			init_buf(len + 1);
+			memcpy(raw_data, c_str, len * sizeof(T));
+			raw_data[len] = 0x00;
+		}
+		/*
+		*** string_base<T>(const T *, unsigned)
+		*** constructor to copy first "len" chars of c_str's value in current string
+		*** automatically inserts null-terminator at the end 
+		*** Version: 1.3.5: Added this contructor
+		*/
+		string_base(const T *c_str, unsigned len, const Alloc &alloc = Alloc())
+			: Alloc(alloc) {
+			this->len = MIN(len, strlength<T>(c_str));
+			init_buf(this->len + 1);
+			memcpy(raw_data, c_str, this->len * sizeof(T));
+			raw_data[this->len] = 0x00;
+		}
+		/*
+		*** string_base<T>(const string_view_base<T> &)
+		*** constructor to copy the chars referenced by "sv" (null chars included)
+		*** automatically inserts null-terminator at the end
+		*** Added with Version 1.9
+		*/
+		explicit string_base(const string_view_base<T> &sv, const Alloc &alloc = Alloc())
+			: Alloc(alloc), len(sv.length()) {
+			init_buf(len + 1);
+			memcpy(raw_data, sv.data(), len * sizeof(T));
+			raw_data[len] = 0x00;
+		}
+		/*
+		*** string_base<T>(const string_base<T> &)
+		*** copy constructor
+		*** just copy "obj" in current value
+		*** also copy allocated state (allocate same amount of space as in "str")
+		*** short strings are always copied into the inline buffer
+		*** automatically inserts null-terminator at the end
+		*** Version 1.9: copies obj's allocator as well
+		*** Version 1.9: shares obj's heap buffer with STR_USE_COW
+		*/
+		string_base(const string_base &obj)
+			: Alloc(obj.get_alloc()), len(obj.len) {
+#ifdef STR_USE_COW
+			if (can_share(obj)) { share_buf(obj); return; }
 #endif
-			memmove(raw_data + (pos + count), raw_data + pos, (len - count - pos) * sizeof(T));
-			memcpy(raw_data + pos, c_str, count * sizeof(T));
+			init_buf((len < (unsigned)sso_cap) ? (unsigned)sso_cap : obj.cap);
+			memcpy(raw_data, obj.raw_data, len * sizeof(T));
 			raw_data[len] = 0x00;
-			return (*this);
 		}
 		/*
-		*** string_base<T> &insert(const T &, unsigned, count)
-		*** inserts ch's value "count" times at position "pos" in this string
-		*** allocates much more memory if needed
-		*** does nothing if 
-			-> Given "pos" is greater than current value's length (this->length())
-			-> count == 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimizing, using memmove() now
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*** string_base<T>(const string_base<T> &, const Alloc &)
+		*** copy constructor using another allocator than "obj"
+		*** Added with Version 1.9
 		*/
-		string_base<T> &insert(const T &ch, unsigned pos, unsigned count) {
-			if (pos > len || !count)
-				return (*this);
-			if (cap <= (len += count)) {
-				cap += (count + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
-			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
+		string_base(const string_base &obj, const Alloc &alloc)
+			: Alloc(alloc), len(obj.len) {
+#ifdef STR_USE_COW
+			if (can_share(obj)) { share_buf(obj); return; }
 #endif
-			memmove(raw_data + (pos + count), raw_data + pos, (len - count - pos) * sizeof(T));
-			for (unsigned i = pos; i < (pos + count); i++)
-				raw_data[i] = ch;
+			init_buf((len < (unsigned)sso_cap) ? (unsigned)sso_cap : obj.cap);
+			memcpy(raw_data, obj.raw_data, len * sizeof(T));
 			raw_data[len] = 0x00;
-			return (*this);
 		}
 		/*
-		*** string_base<T> &insert(const T &, unsigned)
-		*** inserts ch's value at position "pos" in this string
-		*** allocates much more memory if needed
-		*** does nothing if
-			-> Given "pos" is greater than current value's length (this->length())
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimization, using memmove() now
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*** string_base<T>(const concat<T, L, R> &)
+		*** materializes a concatenation built with operator+ ("a + "/" + b")
+		*** allocates exactly (length + 1) spaces once, every part is copied once
+		*** Added with Version 1.9
 		*/
-		string_base<T> &insert(const T &ch, unsigned pos) {
-			if (pos > len) return (*this);
-			if (cap <= (len += 1)) {
-				cap += (1 + STR_ALLOC);
-				raw_data = (T *)realloc(raw_data, (cap * sizeof(T)));
-			}
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
+		template <typename L, typename R>
+		string_base(const concat<T, L, R> &expr, const Alloc &alloc = Alloc())
+			: Alloc(alloc), len(expr.length()) {
+			init_buf(len + 1);
+			expr.write(raw_data);
+			raw_data[len] = 0x00;
+		}
+#ifdef STR_CPP11_OR_HIGHER
+		/*
+		*** string_base<T>(string_base<T> &&)
+		*** move constructor
+		*** takes over obj's heap buffer without copying any chars
+		(short strings are copied out of obj's inline buffer)
+		*** leaves "obj" as an empty string
+		*** Added with Version 1.9
+		*/
+		string_base(string_base &&obj) noexcept
+			: Alloc(obj.get_alloc()) {
+			take_buf(obj);
+		}
 #endif
-			memmove(raw_data + (pos + 1), raw_data + pos, (len - 1 - pos) * sizeof(T));
-			raw_data[pos] = ch;
+#ifdef STR_USE_BINDINGS
+		/*
+		*** string_base<T>(const std_string &)
+		*** copy content from std::basic_string classes
+		*** copies allocated state as well
+		*** automatically inserts null-terminator at the end
+		*** Added with Version 1.4
+		*** Version 1.9: takes an optional allocator
+		*/
+		string_base(const std_string &obj, const Alloc &alloc = Alloc()) 
+			: Alloc(alloc), len(obj.length()) {
+			init_buf(obj.capacity() + 1);
+			memcpy(raw_data, obj.c_str(), len * sizeof(T));
 			raw_data[len] = 0x00;
-			return (*this);
+		}
+#endif
+		/*
+		*** string_base<T>(const string_base<T> &, unsigned, unsigned)
+		*** constructor to assign substring of "str" to current value 
+		(starting at position "start2 with a length of "count")
+		*** allocate ("count" + 1) spaces for substring
+		*** automatically inserts null-terminator at the end
+		*** if "start" is greater than str's length, then start = 0
+		*** Version 1.2: Optimizing, using memcpy() now
+		*** Version 1.2: fix crash when "start" is greater than str's length
+		*** Version 1.9: uses str's allocator (or "alloc")
+		*/
+		explicit string_base(const string_base &str, unsigned start, unsigned count)
+			: Alloc(str.get_alloc()) {
+			init_sub(str.raw_data, str.len, start, count);
+		}
+		explicit string_base(const string_base &str, unsigned start, unsigned count, const Alloc &alloc)
+			: Alloc(alloc) {
+			init_sub(str.raw_data, str.len, start, count);
+		}
+#ifdef STR_USE_BINDINGS
+		/*
+		*** string_base<T>(const string_base<T> &, unsigned, unsigned)
+		*** constructor to assign substring of an std::basic_string sequence
+		(starting at position "start2 with a length of "count")
+		*** automatically inserts null-terminator at the end
+		*** if "start" is greater than str's length, then start = 0
+		*** Added with Version 1.4
+		*** Version 1.9: takes an optional allocator
+		*/
+		explicit string_base(const std_string &str, unsigned start, unsigned count, const Alloc &alloc = Alloc())
+			: Alloc(alloc) {
+			init_sub(str.c_str(), str.length(), start, count);
+		}
+#endif
+		/*
+		*** string_base<T>(const T*, unsigned, unsigned)
+		*** constructor to assign substring of a C-String 
+		(starting at position "start2 with a length of "count")
+		*** allocate enough space ("count" + 1)
+		*** automatically inserts null-terminator at the end
+		*** if "start" is greater than str's length, then start = 0
+		*** Version 1.2: Optimizing, using memcpy() now
+		*** Version 1.2: fix crash when "start" is greater than str's length
+		*** Version 1.9: takes an optional allocator
+		*/
+		explicit string_base(const T *c_str, unsigned start, unsigned count, const Alloc &alloc = Alloc())
+			: Alloc(alloc) {
+			init_sub(c_str, strlength<T>(c_str), start, count);
+		}
+		/*
+		*** ~string_base<T>()
+		*** default destructor to deallocate used memory 
+		*** You might consider using cleanup() instead 
+		(define DEF_USE_CLEANUP_FUNCTION to make it available)
+		*** Readded with Version 1.4
+		*/
+		~string_base() {
+			free_buf();
+#ifdef STR_CPP11_OR_HIGHER
+			/* nullptr is a typesafe alternative to NULL */
+			raw_data = nullptr;
+#else
+			/* C++98 support by avoiding nullptr */
+			raw_data = NULL;
+#endif
 		}
 
+		T *data() { touch(); return raw_data; } /* returns C-String value (detaches a shared buffer, see STR_USE_COW) */
+		const T *data() const { return raw_data; } /* returns C-String (const) value */
+		const T *c_str() const { return (const T *)raw_data; } /* returns C-String (const) value */
+		const unsigned length() const { return len; } /* returns length of current string instance */
+		const unsigned size() const { return len * sizeof(T); } /* returns current size in bytes the actual string with its chars uses */
+		const unsigned capacity() const { return cap; } /* returns maximum number of chars this value can hold in currently allocated state */
+		Alloc get_allocator() const { return get_alloc(); } /* returns a copy of the allocator used by this string */
 		/*
-		*** string_base<T> &erase(unsigned)
-		*** erases character at position "pos" from this string 
-		*** performs no reallocation, doesn't touch capacity but decrements size by 1
-		*** does nothing if
-			-> Given "pos" is greater than highest index of current string value 
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimizing, using memmove() now
+		*** T &at(unsigned) 
+		*** returns reference to a character at position "pos"
+		*** if "pos" is out of range, it returns the last char of string (len - 1)
+		*** Version 1.2: Optimizing, remove "ac_len" variable
 		*/
-		string_base<T> &erase(unsigned pos) {
-			if (pos > (len - 1) || !len) return (*this);
-			memmove(raw_data + pos, raw_data + pos + 1, (len - pos) * sizeof(T));
+		reference at(unsigned pos) { touch(); return raw_data[(pos > (len - 1) ? (len - 1) : pos)]; }
+		/*
+		*** const T &at(unsigned) const
+		*** returns reference to a character at position "pos"
+		*** if "pos" is out of range, it returns the last char of string (len - 1)
+		*** if current string value is const-qualified, it returns this function when 
+		"at" is called outside of the class
+		*** Version 1.2: Optimizing, remove "ac_len" variable
+		*/
+		const_reference at(unsigned pos) const { return raw_data[(pos > (len - 1) ? (len - 1) : pos)]; }
+		/*
+		*** bool at(const T, unsigned)
+		*** checks if given character "ch" is at given position "pos"
+		*** if "pos" is out of range, it compares last char of string (len - 1)
+		*** returns true, if char's value is at position "pos", false if not
+		*** Version 1.2: Optimizing, remove "ac_len" variable
+		*/
+		bool at(const T ch, unsigned pos) { return (raw_data[(pos > (len - 1) ? (len - 1) : pos)] == ch); }
+		/* 
+		*** T &first()
+		*** returns reference to first char of string 
+		*** can be also used to change value of first char
+		*/
+		reference first() { touch(); return raw_data[0]; }
+		/*
+		*** const T &first() const
+		*** returns reference to first char of string
+		*** if current string value is const-qualified, 
+		it returns this function when "first" is called 
+		outside of the class
+		*/
+		const_reference first() const { return raw_data[0]; }
+		/* 
+		*** T &last()
+		*** returns reference to last char of string 
+		*** can be also used to change value of last char
+		*/
+		reference last() {
+			touch();
+			if (!len) return raw_data[0];
+			return raw_data[len - 1];
+		}
+		/*
+		*** const T &last() const
+		*** returns reference to last char of string
+		*** if current string value is const-qualified,
+		it returns this function when "last" is called
+		outside of the class
+		*/
+		const_reference last() const {
+			if (!len) return raw_data[0];
+			return raw_data[len - 1];
+		}
+		bool empty() const { return (len == 0); } /* checks whether string is empty */
+		iterator begin() { touch(); return &raw_data[0]; } /* returns iterator to the beginning of string */
+		iterator end() { touch(); return &raw_data[len]; } /* returns iterator to the ending of string */
+		const_iterator begin() const { return &raw_data[0]; } /* returns constant iterator to the beginning of string */
+		const_iterator end() const { return &raw_data[len]; } /* returns constant iterator to the ending of string */
+		const_iterator cbegin() const { return &raw_data[0]; } /* returns constant iterator to the beginning of string */
+		const_iterator cend() const { return &raw_data[len]; } /* returns constant iterator to the ending of string */
+
+		/*
+		*** unsigned copy(T *, unsigned, unsigned = 0U)
+		*** copy "size" chars of current string object starting from 
+		position "size" to position "pos" in "buffer"
+		*** doesn't modify current string value
+		*** returns number of chars copied
+		*** does nothing if 
+			-> buffer is NULL
+			-> current string data is NULL
+			-> size == 0
+		*** if buffer is too small, behavior is undefined
+		*** Added with Version 1.7
+		*/
+		unsigned copy(T *buffer, unsigned size, unsigned pos = 0U) {
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+			assert(buffer != NULL);
+#else 
+			if (!buffer || !raw_data || !size)
+				return 0;
+#endif
+			if (pos > len) pos = 0;
+			if ((pos + size) > len) size = (len - pos);
+			memcpy(buffer, raw_data + pos, size * sizeof(T));
+			buffer[size] = 0x00;
+			return size;
+		}
+
+		/*
+		*** string_base<T> &splice(string_base<T> &, unsigned, unsigned, unsigned)
+		*** transfer substring of current string value (starting on position "start" 
+		with a length of "size") and insert it in "buffer" at position "pos"
+		*** transfer means, it deletes the substring portion from current string value
+		*** does nothing if
+			-> current string data == NULL
+			-> size == 0
+			-> current string equals to buffer
+		*** returns (eventually) modified string object
+		*** Added with Version 1.7
+		*/
+		string_base &splice(string_base &buffer, unsigned start, unsigned size, unsigned pos) {
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+			assert(this != &buffer);
+#else 
+			if (!raw_data || !size || this == &buffer) return (*this);
+#endif
+			if (start > len) start = 0;
+			if (pos > buffer.len) pos = 0;
+			if ((pos + size) > len) size = (len - pos);
+			buffer.insert(*this, pos, start, size);
+			erase(start, size);
+			return (*this);
+		}
+
+		/*
+		*** string_base<T> &fill(const T &)
+		*** fill whole string buffer with T's value
+		*** inserts null-terminator at the end
+		*** Does nothing if
+			-> len == 0 (string is empty)
+			-> raw_data == NULL (allocation error)
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.5
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &fill(const T &ch) {
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			if (!len) return (*this);
+			touch();
+			for (unsigned i = 0; i < len; i++)
+				raw_data[i] = ch;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &fill(const T &)
+		*** fill first "count" places in 
+		string buffer with T's value
+		*** inserts null-terminator at the end
+		*** Does nothing if
+			-> len == 0 (string is empty)
+			-> raw_data == NULL (allocation error)
+			-> count == 0 (no chars to copy)
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.5
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &fill(const T &ch, unsigned count) {
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			if (!len || !count) return (*this);
+			touch();
+			unsigned ac_len = MIN(count, len);
+			for (unsigned i = 0; i < ac_len; i++)
+				raw_data[i] = ch;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &fill(const T &)
+		*** fill substring of string buffer with T's value
+		*** inserts null-terminator at the end
+		*** Does nothing if
+			-> len == 0 (string is empty)
+			-> raw_data == NULL (allocation error)
+			-> count == 0 (no chars to copy)
+		*** If start is greater than current string length, then start = 0
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.5
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &fill(const T &ch, unsigned start, unsigned count) {
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			if (!len || !count) return (*this);
+			touch();
+			if (start > len) start = 0;
+			if ((start + count) > len) count = (len - start);
+			for (unsigned i = start; i < (start + count); i++)
+				raw_data[i] = ch;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+
+		/*
+		*** string_base<T> &assign(const T *)
+		*** assign c_str's value to this string 
+		*** old data is lost once you call this function
+		*** reuses the current buffer if it's large enough, reallocates otherwise
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimization, using memcpy() now
+		*** Version 1.9: keep buffer if c_str's value fits into it
+		*/
+		string_base &assign(const T *c_str) {
+			drop_hash();
+			if (!*c_str) return (*this);
+			unshare();
+			len = strlength<T>(c_str);
+			discard_buf(len + 1);
+			memmove(raw_data, c_str, len * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &assign(const T *, unsigned)
+		*** assigns the first "len" characters of "c_str" to this string
+		*** old data is lost once you call this function
+		*** reuses the current buffer if it's large enough, reallocates otherwise
+		*** returns (modified) *this object
+		*** Version 1.2: Optimization, using memcpy() now
+		*** Version 1.3.5: 
+				raw_data[len] = 0x00; 
+			has been changed to
+				raw_data[this->len] = 0x00;
+		*** Version 1.9: keep buffer if the chars fit into it
+		*/
+		string_base &assign(const T *c_str, unsigned len) {
+			drop_hash();
+			if (!*c_str || !len) return (*this);
+			unshare();
+			unsigned ac_len = MIN(len, strlength<T>(c_str));
+			this->len = ac_len;
+			discard_buf(this->len + 1);
+			memmove(raw_data, c_str, this->len * sizeof(T));
+			raw_data[this->len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &assign(const string_base<T> &)
+		*** assign str's value to this string 
+		*** old data is lost once you call this function
+		*** reuses the current buffer if it's large enough, reallocates otherwise
+		*** does nothing if 
+			-> you try to assign *this to this string
+			-> str's length is 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimization, using memcpy() now
+		*** Version 1.9: keep buffer if str's value fits into it
+		*** Version 1.9: shares str's heap buffer with STR_USE_COW
+		*/
+		string_base &assign(const string_base &str) {
+			if (this == &str) return (*this);
+#ifdef STR_USE_COW
+			if (can_share(str)) {
+				drop_hash();
+				free_buf();
+				share_buf(str);
+				return (*this);
+			}
+#endif
+			unshare();
+			len = str.len;
+			discard_buf(len + 1);
+			memcpy(raw_data, str.raw_data, len * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &assign(const concat<T, L, R> &)
+		*** assigns a concatenation built with operator+ (s = a + "/" + b)
+		*** reuses the current buffer if the result fits into it, allocates 
+		exactly (length + 1) spaces otherwise
+		*** the expression may refer to this string's own value
+		*** returns (modified) *this object
+		*** Added with Version 1.9
+		*/
+		template <typename L, typename R>
+		string_base &assign(const concat<T, L, R> &expr) {
+			unshare();
+			if (expr.overlaps(raw_data, raw_data + len)) {
+				string_base tmp(expr, get_alloc());
+				free_buf();
+				take_buf(tmp);
+				return (*this);
+			}
+			len = expr.length();
+			discard_buf(len + 1);
+			expr.write(raw_data);
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &assign(const string_view_base<T> &)
+		*** assigns the chars referenced by "sv" to this string (null chars included)
+		*** "sv" may reference this string's own value
+		*** returns (modified) *this object
+		*** Added with Version 1.9
+		*/
+		string_base &assign(const string_view_base<T> &sv) {
+			unshare();
+			unsigned l = sv.length();
+			if (sv.data() >= raw_data && sv.data() <= raw_data + len) 
+				memmove(raw_data, sv.data(), l * sizeof(T));	/* slice of this string */
+			else {
+				discard_buf(l + 1);
+				memcpy(raw_data, sv.data(), l * sizeof(T));
+			}
+			len = l;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+#ifdef STR_CPP11_OR_HIGHER
+		/*
+		*** string_base<T> &assign(string_base<T> &&)
+		*** move str's value to this string
+		*** frees the old buffer and takes over str's one (and its allocator), no chars are copied
+		(short strings are copied out of str's inline buffer)
+		*** leaves "str" as an empty string
+		*** does nothing if you try to assign *this to this string
+		*** returns (modified) *this object
+		*** Added with Version 1.9
+		*/
+		string_base &assign(string_base &&str) noexcept {
+			if (this == &str) return (*this);
+			drop_hash();
+			free_buf();
+			get_alloc() = str.get_alloc();
+			take_buf(str);
+			return (*this);
+		}
+#endif
+#ifdef STR_USE_BINDINGS
+		/*
+		*** string_base<T> &assign(const str_string &)
+		*** assign str's value to this string
+		*** old data is lost once you call this function
+		*** reuses the current buffer if it's large enough, reallocates otherwise
+		*** does nothing if
+			-> str's length is 0
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.4
+		*/
+		string_base &assign(const std_string &str) {
+			unshare();
+			len = str.length();
+			discard_buf(len + 1);
+			memcpy(raw_data, str.c_str(), len * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+#endif
+		/*
+		*** string_base<T> &assign(const T &, unsigned len)
+		*** assigns ch's value to this string (actually, "len" times)
+		*** old data is lost once you call this function
+		*** reuses the current buffer if it's large enough, reallocates otherwise
+		*** returns (modified) *this object
+		*/
+		string_base &assign(const T &ch, unsigned len) {
+			drop_hash();
+			if (!len) return (*this);
+			unshare();
+			this->len = len;
+			discard_buf(len + 1);
+			for (unsigned i = 0; i < len; i++)
+				raw_data[i] = ch;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &assign(string_base<T> &, unsigned, unsigned)
+		*** assigns a substring of "str" (starting at "start" with a length 
+		of "count") to this string
+		*** old data is lost once you call this function
+		*** reuses the current buffer if it's large enough, reallocates otherwise
+		*** does nothing if 
+			-> you try to assign *this with same length to this string
+			-> substring's length ("count") == 0
+		*** if "start" is greater than str's length, then start = 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimization, using memcpy() now
+		*** based on this article: https://www.includehelp.com/c-programs/substring-implementation.aspx
+		*/
+		string_base &assign(const string_base &str, unsigned start, unsigned count) {
+			drop_hash();
+			if (!count || (this == &str && start == 0 && count == len))
+				return (*this);
+			unsigned l = str.len;
+			if (start > l) start = 0;
+			if ((start + count) > l) 
+				count = (l - start);
+			const T *src = str.raw_data + start;	/* a released shared buffer stays alive for its other owners */
+			unshare();
+			len = count;
+			discard_buf(len + 1);
+			memmove(raw_data, src, len * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+#ifdef STR_USE_BINDINGS
+		/*
+		*** string_base<T> &assign(const std_string &, unsigned, unsigned)
+		*** assigns a substring of "str" (starting at "start" with a length 
+		of "count") to this string
+		*** old data is lost once you call this function
+		*** reuses the current buffer if it's large enough, reallocates otherwise
+		*** does nothing if
+			-> substring's length ("count") == 0
+		*** if "start" is greater than str's length, then start = 0
+		*** returns (eventually modified) *this object
+		*** Added with Verson 1.4
+		*/
+		string_base &assign(const std_string &str, unsigned start, unsigned count) {
+			return assign(str.c_str(), start, count);
+		}
+#endif
+		/*
+		*** string_base<T> &assign(const T *, unsigned, unsigned)
+		*** assigns a substring of "c_str" (starting at "start" with a length
+		of "count") to this string
+		*** old data is lost once you call this function
+		*** reuses the current buffer if it's large enough, reallocates otherwise
+		*** does nothing if
+		-> c_str's value == ""
+		-> substring's length ("count") == 0
+		*** if "start" is greater than c_str's length, then start = 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Added this assign overload
+		*/
+		string_base &assign(const T *c_str, unsigned start, unsigned count) {
+			drop_hash();
+			if (!*c_str || !count) return (*this);
+			unshare();
+			unsigned l = strlength<T>(c_str);
+			if (start > l) start = 0;
+			if ((start + count) > l)
+				count = (l - start);
+			len = count;
+			discard_buf(len + 1);
+			memmove(raw_data, c_str + start, len * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+
+		/*
+		*** string_base<T> &append(const T *)
+		*** append c_str's value to this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> first character of c_str's value == 0x00
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimization, using memcpy() now
+		*** Version 1.6: Added assertions to make debugging the program easier 
+		*/
+		string_base &append(const T *c_str) {
+			if (!*c_str) return (*this);
+			touch();
+			unsigned old = len, l = strlength<T>(c_str);
+			grow_buf(len + l + 1);
+			len += l;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL); 
+#endif
+			memcpy(raw_data + old, c_str, (len - old) * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &append(const T &)
+		*** appends ch's value to this string 
+		*** allocates much more memory if needed
+		*** returns (modified) *this object
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &append(const T &ch) {
+			touch();
+			grow_buf(len + 2);
+			len += 1;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			raw_data[len - 1] = ch;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &append(const T &, unsigned)
+		*** appends ch's value "count" times to this string
+		*** allocates much more memory if needed
+		*** does nothing if 
+			-> count == 0
+		*** returns (eventually modified) *this object
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &append(const T &ch, unsigned count) {
+			if (!count) return (*this);
+			touch();
+			unsigned o = len;
+			grow_buf(len + count + 1);
+			len += count;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			for (unsigned i = o; i < (o + count); i++)
+				raw_data[i] = ch;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &append(const string_base<T> &)
+		*** appends str's value to this string
+		*** allocates much more memory if needed
+		*** does nothing if 
+			-> str's length == 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimization, using memcpy() now
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &append(const string_base &str) {
+			if (!str.len) return (*this);
+			touch();
+			if (this == &str) {
+				append(string_base(str));
+				return (*this);
+			}
+			unsigned o = len, l = str.len;
+			grow_buf(len + l + 1);
+			len += l;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			memcpy(raw_data + o, str.raw_data, (len - o) * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &append(const string_view_base<T> &)
+		*** appends the chars referenced by "sv" to this string (null chars included)
+		*** "sv" may reference this string's own value
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.9
+		*/
+		string_base &append(const string_view_base<T> &sv) {
+			unsigned o = len, l = sv.length();
+			if (!l) return (*this);
+			touch();
+			const T *src = sv.data();
+			bool self = (src >= raw_data && src < raw_data + len);
+			unsigned off = self ? (unsigned)(src - raw_data) : 0;
+			grow_buf(len + l + 1);
+			if (self) src = raw_data + off;	/* the buffer may have moved */
+			len += l;
+			memcpy(raw_data + o, src, l * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &append(const concat<T, L, R> &)
+		*** appends a concatenation built with operator+ (s += a + "/" + b)
+		*** checks the capacity once for the whole expression and copies every part once
+		*** the expression may refer to this string's own value
+		*** returns (modified) *this object
+		*** Added with Version 1.9
+		*/
+		template <typename L, typename R>
+		string_base &append(const concat<T, L, R> &expr) {
+			touch();
+			unsigned l = expr.length();
+			if (len + l + 1 > cap && expr.overlaps(raw_data, raw_data + len)) {
+				string_base tmp(Growth::grow(cap, len + l + 1, sizeof(T)), get_alloc());
+				memcpy(tmp.raw_data, raw_data, len * sizeof(T));
+				tmp.len = len;
+				tmp.append(expr);
+				free_buf();
+				take_buf(tmp);
+				return (*this);
+			}
+			grow_buf(len + l + 1);
+			expr.write(raw_data + len);
+			len += l;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+#ifdef STR_USE_BINDINGS
+		/*
+		*** string_base<T> &append(const std_string &)
+		*** appends str's value to this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> str's length == 0
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.4
+		*/
+		string_base &append(const std_string &str) {
+			return append(str.c_str());
+		}
+#endif
+		/*
+		*** string_base<T> &append(const T *, unsigned)
+		*** appends the first "count" characters of c_str's value to this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> first character of "c_str" == 0x00
+			-> count == 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimization, using memcpy() now
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &append(const T *c_str, unsigned count) {
+			if (!*c_str || !count) return (*this);
+			touch();
+			unsigned ac_len = MIN(count, strlength<T>(c_str));
+			unsigned o = len;
+			grow_buf(len + ac_len + 1);
+			len += ac_len;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			memcpy(raw_data + o, c_str, ac_len * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &append(const T *, unsigned, unsigned)
+		*** appends a substring of "c_str" (starting at position 
+		"start" with a length of "count") to this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> substring's length ("count") == 0
+			-> first character of c_str's value == 0x00
+		*** if "start" is greater than c_str's length, then start = 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimization, using memcpy() now
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &append(const T *c_str, unsigned start, unsigned count) {
+			if (!count || !*c_str) return (*this);
+			touch();
+			unsigned o = len;
+			unsigned l = strlength<T>(c_str);
+			if (start > l) start = 0;
+			if ((start + count) > l) 
+				count = (l - start);
+			grow_buf(len + count + 1);
+			len += count;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			memcpy(raw_data + o, c_str + start, count * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &append(const string_base<T> &, unsigned, unsigned)
+		*** appends a substring of "str" (starting at position "start" with a 
+		length of "count") to this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> substring's length ("count") == 0
+			-> str's length == 0
+		*** if "start" is greater than str's length, then start = 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimization, using memcpy() now
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &append(const string_base &str, unsigned start, unsigned count) {
+			if (!count || !str.len) return (*this);
+			touch();
+			if (this == &str) {
+				append(string_base(str), start, count);
+				return (*this);
+			}
+			unsigned o = len;
+			unsigned l = str.len;
+			if (start > l) start = 0;
+			if ((start + count) > l) 
+				count = (l - start);
+			grow_buf(len + count + 1);
+			len += count;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			memcpy(raw_data + o, str.raw_data + start, count * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+#ifdef STR_USE_BINDINGS
+		/*
+		*** string_base<T> &append(const string_base<T> &, unsigned, unsigned)
+		*** appends a substring of "str" (starting at position "start" with a
+		length of "count") to this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> substring's length ("count") == 0
+			-> str's length == 0
+		*** if "start" is greater than str's length, then start = 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimization, using memcpy() now
+		*/
+		string_base &append(const std_string &str, unsigned start, unsigned count) {
+			return append(str.c_str(), start, count);
+		}
+#endif
+		/*
+		*** string_base<T> &append_number(N)
+		*** appends the decimal text of the integer "value" (any width, signed or unsigned)
+		*** counts the digits first and writes them backwards into the tail, two
+		at a time from a table of digit pairs (one capacity check, no temporary buffer)
+		*** returns (modified) *this object
+		*** Added with Version 1.9
+		*/
+		template <typename N>
+		string_base &append_number(N value) {
+			touch();
+			bool neg = numeric::sign_of<numeric::int_limits<N>::is_signed != 0>::negative(value);
+			_ull_ v = neg ? (_ull_)0 - (_ull_)value : (_ull_)value;
+			unsigned n = numeric::count_digits(v) + (neg ? 1 : 0);
+			grow_buf(len + n + 1);
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			if (neg) raw_data[len] = T('-');
+			len += n;
+			if (v <= 0xFFFFFFFFULL) numeric::write_uint(raw_data + len, (unsigned)v);
+			else numeric::write_uint(raw_data + len, v);
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &append_number(float)
+		*** string_base<T> &append_number(double)
+		*** appends the shortest text that reads back as exactly "value" (Ryu),
+		fixed notation if it's not longer than scientific one ("1e+22", "0.001",
+		"1.5e-07"), fixed integers are exact ("876318528" for 876318528.0f) like 
+		std::to_chars(), "inf", "-inf", "nan" and "-nan" for the special values
+		*** returns (modified) *this object
+		*** Added with Version 1.9
+		*/
+		string_base &append_number(float value) { return append_float(value); }
+		string_base &append_number(double value) { return append_float(value); }
+		/*
+		*** string_base<T> from_number(N)
+		*** returns the text of an integer, float or double (see append_number())
+		*** Added with Version 1.9
+		*/
+		template <typename N>
+		static string_base from_number(N value) {
+			string_base s;
+			s.append_number(value);
+			return s;
+		}
+		/*
+		*** utf_result assign_utf(const S *, unsigned)
+		*** utf_result assign_utf(const string_view_base<S> &)
+		*** utf_result assign_utf(const string_base<S, A, G> &)
+		*** assigns the "count" code units at "src" converted from the encoding of 
+		S to the one of T (UTF-8, UTF-16 or UTF-32 by sizeof, see str::utf_length())
+		*** validates and measures the source first, the buffer is allocated at most once
+		*** returns the result of the validation, the string is unchanged if the 
+		source is invalid ("pos" tells where)
+		*** Added with Version 1.9
+		*/
+		template <typename S>
+		utf_result assign_utf(const S *src, unsigned count) {
+			utf_result r = utf_length<T>(src, count);
+			if (!r.ok()) return r;
+			unshare();
+			if (overlaps_buf(src, count)) {
+				string_base tmp(r.length + 1, get_alloc());
+				tmp.len = utf_convert(src, count, tmp.raw_data);
+				tmp.raw_data[tmp.len] = 0x00;
+				free_buf();
+				take_buf(tmp);
+				return r;
+			}
+			len = r.length;
+			discard_buf(len + 1);
+			utf_convert(src, count, raw_data);
+			raw_data[len] = 0x00;
+			return r;
+		}
+		template <typename S>
+		utf_result assign_utf(const string_view_base<S> &src) { return assign_utf(src.data(), src.length()); }
+		template <typename S, typename A, typename G>
+		utf_result assign_utf(const string_base<S, A, G> &src) { return assign_utf(src.c_str(), src.length()); }
+		/*
+		*** utf_result append_utf(const S *, unsigned)
+		*** utf_result append_utf(const string_view_base<S> &)
+		*** utf_result append_utf(const string_base<S, A, G> &)
+		*** appends the "count" code units at "src" converted to the encoding of T (see assign_utf())
+		*** returns the result of the validation, the string is unchanged if the source is invalid
+		*** Added with Version 1.9
+		*/
+		template <typename S>
+		utf_result append_utf(const S *src, unsigned count) {
+			utf_result r = utf_length<T>(src, count);
+			if (!r.ok() || !r.length) return r;
+			touch();
+			if (len + r.length + 1 > cap && overlaps_buf(src, count)) {
+				string_base tmp(Growth::grow(cap, len + r.length + 1, sizeof(T)), get_alloc());
+				memcpy(tmp.raw_data, raw_data, len * sizeof(T));
+				tmp.len = len + utf_convert(src, count, tmp.raw_data + len);
+				tmp.raw_data[tmp.len] = 0x00;
+				free_buf();
+				take_buf(tmp);
+				return r;
+			}
+			grow_buf(len + r.length + 1);
+			len += utf_convert(src, count, raw_data + len);
+			raw_data[len] = 0x00;
+			return r;
+		}
+		template <typename S>
+		utf_result append_utf(const string_view_base<S> &src) { return append_utf(src.data(), src.length()); }
+		template <typename S, typename A, typename G>
+		utf_result append_utf(const string_base<S, A, G> &src) { return append_utf(src.c_str(), src.length()); }
+		/*
+		*** string_base<T> &insert(const string_base<T> &, unsigned)
+		*** insert str's value at position "pos" in this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> Given "pos" is greater than current value's length (this->length())
+			-> str's length == 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimizing, using memmove() and memcpy() now
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &insert(const string_base &str, unsigned pos) {
+			if (pos > len || !str.len) return (*this);
+			touch();
+			if (this == &str) {
+				insert(string_base(str), pos);
+				return (*this);
+			}
+			grow_buf(len + str.len + 1);
+			len += str.len;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			memmove(raw_data + (pos + str.len), raw_data + pos, (len - str.len - pos) * sizeof(T));
+			memcpy(raw_data + pos, str.raw_data, str.len * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &insert(const string_base<T> &, unsigned, unsigned, unsigned)
+		*** inserts a substring of "str" (starting at position "start" with a length of 
+		"count") at position "pos" in this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> Given "pos" is greater than current value's length (this->length())
+			-> substring's length ("count") == 0
+		*** if "start" is greater than str's length, then start = 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimizing, using memmove() and memcpy() now
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &insert(const string_base &str, unsigned pos, unsigned start, unsigned count) {
+			if (pos > len || !count) return (*this);
+			touch();
+			if (this == &str) {
+				insert(string_base(str), pos, start, count);
+				return (*this);
+			}
+			unsigned l = str.len;
+			if (start > l) start = 0;
+			if ((start + count) > l) 
+				count = (l - start);
+			grow_buf(len + count + 1);
+			len += count;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			memmove(raw_data + (pos + count), raw_data + pos, (len - count - pos) * sizeof(T));
+			memcpy(raw_data + pos, str.raw_data + start, count * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+#ifdef STR_USE_BINDINGS
+		/*
+		*** string_base<T> &insert(const std_string &, unsigned, unsigned, unsigned)
+		*** inserts a substring of "str" (starting at position "start" with a length of
+		"count") at position "pos" in this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> Given "pos" is greater than current value's length (this->length())
+			-> substring's length ("count") == 0
+		*** if "start" is greater than str's length, then start = 0
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.4
+		*/
+		string_base &insert(const std_string &str, unsigned pos, unsigned start, unsigned count) {
+			return insert(str.c_str(), pos, start, count);
+		}
+#endif
+		/*
+		*** string_base<T> &insert(const string_base<T> &, unsigned, unsigned)
+		*** inserts the first "count" characters of str's value at position "pos" in this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> Given "pos" is greater than current value's length (this->length())
+			-> str's length == 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimizing, using memmove() and memcpy() now
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &insert(const string_base &str, unsigned pos, unsigned count) {
+			if (pos > len || !str.len)
+				return (*this);
+			touch();
+			if (this == &str) {
+				insert(string_base(str), pos, count);
+				return (*this);
+			}
+			if (count > str.len)
+				count -= (count - str.len);
+			grow_buf(len + count + 1);
+			len += count;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			memmove(raw_data + (pos + count), raw_data + pos, (len - count - pos) * sizeof(T));
+			memcpy(raw_data + pos, str.raw_data, count * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+#ifdef STR_USE_BINDINGS
+		/*
+		*** string_base<T> &insert(const std_string &, unsigned, unsigned)
+		*** inserts the first "count" characters of str's value at position "pos" in this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> Given "pos" is greater than current value's length (this->length())
+			-> str's length == 0
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.4
+		*/
+		string_base &insert(const std_string &str, unsigned pos, unsigned count) {
+			return insert(str.c_str(), pos, count);
+		}
+#endif
+		/*
+		*** string_base<T> &insert(const T *, unsigned)
+		*** inserts c_str's value at position "pos" in this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> Given "pos" is greater than current value's length (this->length())
+			-> first character of c_str's value == 0x00
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimizing, using memmove() and memcpy() now
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &insert(const T *c_str, unsigned pos) {
+			if (pos > len || !*c_str) return (*this);
+			touch();
+			unsigned l = strlength<T>(c_str);
+			grow_buf(len + l + 1);
+			len += l;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			memmove(raw_data + (pos + l), raw_data + pos, (len - l - pos) * sizeof(T));
+			memcpy(raw_data + pos, c_str, l * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &insert(const T *, unsigned, unsigned, unsigned)
+		*** inserts a substring of "c_str" (starting at position "start" with a 
+		length of "count") at position "pos" in this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> Given "pos" is greater than current value's length (this->length())
+			-> substring's length ("count") == 0
+			-> first character of c_str's value == 0x00
+		*** if "start" is greater than str's length, then start = 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimizing, using memmove() and memcpy() now
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &insert(const T *c_str, unsigned pos, unsigned start, unsigned count) {
+			if (pos > len || !count || !*c_str) return (*this);
+			touch();
+			unsigned o = len;
+			unsigned l = strlength<T>(c_str);
+			if (start > count) start = 0;
+			if ((start + count) > l) 
+				count = (l - start);
+			grow_buf(len + count + 1);
+			len += count;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			memmove(raw_data + (pos + count), raw_data + pos, (len - count - pos) * sizeof(T));
+			memcpy(raw_data + pos, c_str + start, count * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &insert(const T *, unsigned, unsigned)
+		*** inserts the first "count" chars of c_str's value at position "pos" in this string
+		*** allocates much more memory if needed
+		*** does nothing if 
+			-> Given "pos" is greater than current value's length (this->length())
+			-> substring's length ("count") == 0
+			-> first character of c_str's value == 0x00
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimizing, using memmove() and memcpy() now
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &insert(const T *c_str, unsigned pos, unsigned count) {
+			if (pos > len || !count || !*c_str)
+				return (*this);
+			touch();
+			unsigned l = strlength<T>(c_str);
+			if (count > l) count -= (count - l);
+			grow_buf(len + count + 1);
+			len += count;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			memmove(raw_data + (pos + count), raw_data + pos, (len - count - pos) * sizeof(T));
+			memcpy(raw_data + pos, c_str, count * sizeof(T));
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &insert(const T &, unsigned, count)
+		*** inserts ch's value "count" times at position "pos" in this string
+		*** allocates much more memory if needed
+		*** does nothing if 
+			-> Given "pos" is greater than current value's length (this->length())
+			-> count == 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimizing, using memmove() now
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &insert(const T &ch, unsigned pos, unsigned count) {
+			if (pos > len || !count)
+				return (*this);
+			touch();
+			grow_buf(len + count + 1);
+			len += count;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			memmove(raw_data + (pos + count), raw_data + pos, (len - count - pos) * sizeof(T));
+			for (unsigned i = pos; i < (pos + count); i++)
+				raw_data[i] = ch;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+		/*
+		*** string_base<T> &insert(const T &, unsigned)
+		*** inserts ch's value at position "pos" in this string
+		*** allocates much more memory if needed
+		*** does nothing if
+			-> Given "pos" is greater than current value's length (this->length())
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimization, using memmove() now
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		string_base &insert(const T &ch, unsigned pos) {
+			if (pos > len) return (*this);
+			touch();
+			grow_buf(len + 2);
+			len += 1;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			memmove(raw_data + (pos + 1), raw_data + pos, (len - 1 - pos) * sizeof(T));
+			raw_data[pos] = ch;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+
+		/*
+		*** string_base<T> &erase(unsigned)
+		*** erases character at position "pos" from this string 
+		*** performs no reallocation, doesn't touch capacity but decrements size by 1
+		*** does nothing if
+			-> Given "pos" is greater than highest index of current string value 
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimizing, using memmove() now
+		*/
+		string_base &erase(unsigned pos) {
+			if (pos > (len - 1) || !len) return (*this);
+			touch();
+			memmove(raw_data + pos, raw_data + pos + 1, (len - pos) * sizeof(T));
 			--this->len;
 			raw_data[len] = 0x00;
 			return (*this);
 		}
-		/*
-		*** string_base<T> &erase(unsigned, unsigned)
-		*** erases a sequence of characters (starting at position "pos" with a length of "count") from this string 
-		*** performs no reallocation, doesn't touch capacity but decrements size by "count"
-		*** does nothing if 
-			-> Given "pos" is greater than highest index of current string value
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimizing, using memmove() now
-		*/
-		string_base<T> &erase(unsigned pos, unsigned count) {
-			if (pos > (len - 1) || !len) return (*this);
-			if ((pos + count) > len) count = (len - pos);
-			memmove(raw_data + pos, raw_data + pos + count, (len - count - pos) * sizeof(T));
-			this->len -= count;
-			raw_data[len] = 0x00;
-			return (*this);
+		/*
+		*** string_base<T> &erase(unsigned, unsigned)
+		*** erases a sequence of characters (starting at position "pos" with a length of "count") from this string 
+		*** performs no reallocation, doesn't touch capacity but decrements size by "count"
+		*** does nothing if 
+			-> Given "pos" is greater than highest index of current string value
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimizing, using memmove() now
+		*/
+		string_base &erase(unsigned pos, unsigned count) {
+			if (pos > (len - 1) || !len) return (*this);
+			touch();
+			if ((pos + count) > len) count = (len - pos);
+			memmove(raw_data + pos, raw_data + pos + count, (len - count - pos) * sizeof(T));
+			this->len -= count;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+
+		/*
+		*** string_base<T> &substr(unsigned, unsigned)
+		*** generates a substring of current string value (starting at position "pos" with a length of "count")
+		*** performs no reallocation, changes size but not capacity
+		*** does nothing if
+			-> Given "pos" is greater than highest index of current string value
+			-> substring's length ("count") == 0
+		*** if "start" is greater than str's length, then start = 0
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimizing, using memcpy() now
+		*** Version 1.9: moves the substring to the front of the buffer instead of reallocating
+		*/
+		string_base &substr(unsigned start, unsigned count) {
+			if (start > (len - 1) || !count) return (*this);
+			touch();
+			if ((start + count) > len)
+				count = (len - start);
+			memmove(raw_data, raw_data + start, count * sizeof(T));
+			this->len = count;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+
+		/*
+		*** string_base<T> &remove(const T &)
+		*** removes a specified character value represented by "ch" from whole string
+		*** changes size but not capacity
+		*** does nothing if
+			-> current string's length == 0
+			-> ch's value == 0x00 (null-terminator)
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimizing, using another remove() overload now
+		*/
+		string_base &remove(const T &ch) { remove((T)ch, 0, len); return (*this); }
+		/*
+		*** string_base<T> &remove(const T &, unsigned, unsigned)
+		*** removes a specified character represented by ch's value 
+		from a specified range within this string value 
+		(starting with position "start" with a length of "count")
+		*** performs a reallocation, changes size but not capacity
+		*** does nothing if 
+			-> current string's length == 0
+			-> substring's length ("count") == 0
+			-> ch's value == 0x00 (null-terminator)
+			-> Given "pos" is greater than highest index of current string value
+		*** returns (eventually modified) *this object
+		*** Version 1.2: Optimizing, using memmove() now
+		*** Version 1.9: single pass stream compaction (SSSE3 for 1-byte chars), 
+		consecutive "ch" are all removed now
+		*/
+		string_base &remove(const T &ch, unsigned start, unsigned count) {
+			if (!len || !count || !ch || start > (len - 1))
+				return (*this);
+			if (count > len - start)
+				count = (len - start);
+			unsigned i = simd::find_char(raw_data + start, count, ch);
+			if (i == count) return (*this);
+			touch();
+			close_gap(start + i, count - i, simd::remove_char(raw_data + start + i, count - i, ch));
+			return (*this);
+		}
+		/*
+		*** string_base<T> &remove_any(const T *)
+		*** removes every char of the null-terminated "set" from whole string in one pass
+		*** changes size but not capacity
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.9
+		*/
+		string_base &remove_any(const T *set) { return remove_if(char_set<T>(set, strlength<T>(set))); }
+		/*
+		*** string_base<T> &remove_any(const string_base<T> &)
+		*** removes every char of "set" from whole string in one pass
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.9
+		*/
+		string_base &remove_any(const string_base &set) {
+			if (this == &set) { clear(); return (*this); }
+			return remove_if(char_set<T>(set.raw_data, set.len));
+		}
+		/*
+		*** string_base<T> &remove_if(Pred)
+		*** removes every char "c" for which pred(c) returns true from whole string in one pass
+		*** "pred" is called exactly once per char, in order
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.9
+		*/
+		template <typename Pred>
+		string_base &remove_if(Pred pred) {
+			unsigned w = 0;
+			while (w < len && !pred(raw_data[w])) ++w;
+			if (w == len) return (*this);
+			touch();
+			for (unsigned i = w + 1; i < len; i++)
+				if (!pred(raw_data[i])) raw_data[w++] = raw_data[i];
+			len = w;
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+
+		/*
+		*********************************************************************
+		*** string comparison table										  ***
+		*********************************************************************
+
+		compared string = *this
+
+		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+		*     * Either the value of the first character that does not		*
+		* <0  * match is lower in the compared string, or all compared		*
+		*     * characters match but the compared string is shorter.		*
+		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+		*     *																*
+		* =0  * They compare equal (so str1 == str2).						*
+		*     *																*
+		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+		*     * Either the value of the first character that does not		*
+		* >0  * match is greater in the compared string, or all compared	*
+		*     * characters match but the compared string is longer.			*
+		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+		* from: http://www.cplusplus.com/reference/string/string/compare/	*																
+		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+		*/
+
+		/*
+		*** int compare(const string_base<T> &) const
+		*** compares current string value with str's value 
+		*** for return value, please look at the "string comparison table" table above
+		*** Version 1.9: compares the stored lengths (binary-safe), SIMD mismatch search
+		*/
+		int compare(const string_base &str) const { return compare_n(raw_data, len, str.raw_data, str.len); }
+		/*
+		*** int compare(const string_base<T> &, unsigned, unsigned) const
+		*** compares current string value with a substring of str's value 
+		starting at position "start" with a length of "count"
+		(the substring is clipped to the end of str's value)
+		*** for return value, please look at the "string comparison table" table above
+		*/
+		int compare(const string_base &str, unsigned start, unsigned count) const {
+			clip(str.len, start, count);
+			return compare_n(raw_data, len, str.raw_data + start, count);
+		}
+		/*
+		*** int compare(const string_base<T> &, unsigned, unsigned, unsigned, unsigned) const
+		*** compares a substring of current string with a substring of str's value
+		*** parameters:
+			-> str			- other string value which substring is compared with a substring of current value
+			-> s1pos		- starting position of current value's substring
+			-> s1count		- length of current value's substring
+			-> s2pos		- starting position of str's substring
+			-> s2count		- length of str's substring
+		*** both substrings are clipped to the end of their string
+		*** for return value, please look at the "string comparison table" table above
+		*/
+		int compare(const string_base &str, unsigned s1pos, unsigned s1count, unsigned s2pos, unsigned s2count) const {
+			clip(len, s1pos, s1count);
+			clip(str.len, s2pos, s2count);
+			return compare_n(raw_data + s1pos, s1count, str.raw_data + s2pos, s2count);
+		}
+#ifdef STR_USE_BINDINGS
+		/*
+		*** int compare(const std_string &) const
+		*** compares current string value with str's value
+		*** for return value, please look at the "string comparison table" table above
+		*** Added with Version 1.4
+		*/
+		int compare(const std_string &str) const { return compare_n(raw_data, len, str.data(), (unsigned)str.length()); }
+		/*
+		*** int compare(const std_string &, unsigned, unsigned) const
+		*** compares current string value with a substring of str's value
+		starting at position "start" with a length of "count"
+		(the substring is clipped to the end of str's value)
+		*** for return value, please look at the "string comparison table" table above
+		*** Added with Version 1.4
+		*/
+		int compare(const std_string &str, unsigned start, unsigned count) const {
+			clip((unsigned)str.length(), start, count);
+			return compare_n(raw_data, len, str.data() + start, count);
+		}
+		/*
+		*** int compare(const std_string &, unsigned, unsigned, unsigned, unsigned) const
+		*** compares a substring of current string with a substring of str's value
+		*** parameters:
+			-> str			- other string value which substring is compared with a substring of current value
+			-> s1pos		- starting position of current value's substring
+			-> s1count		- length of current value's substring
+			-> s2pos		- starting position of str's substring
+			-> s2count		- length of str's substring
+		*** both substrings are clipped to the end of their string
+		*** for return value, please look at the "string comparison table" table above
+		*** Added with Version 1.4
+		*/
+		int compare(const std_string &str, unsigned s1pos, unsigned s1count, unsigned s2pos, unsigned s2count) const {
+			clip(len, s1pos, s1count);
+			clip((unsigned)str.length(), s2pos, s2count);
+			return compare_n(raw_data + s1pos, s1count, str.data() + s2pos, s2count);
+		}
+#endif
+		/*
+		*** int compare(const T *) const 
+		*** compares current string value with c_str's value 
+		*** for return value, please look at the "string comparison table" table above
+		*/
+		int compare(const T *c_str) const { return compare_n(raw_data, len, c_str, strnlength(c_str, len + 1)); }
+		/*
+		*** int compare(const T *, unsigned, unsigned) const
+		*** compares current string value with a substring of c_str's value
+		starting at position "start" with a length of "count"
+		(the substring is clipped to the end of c_str's value)
+		*** for return value, please look at the "string comparison table" table above
+		*/
+		int compare(const T *c_str, unsigned start, unsigned count) const {
+			clip(strlength<T>(c_str), start, count);
+			return compare_n(raw_data, len, c_str + start, count);
+		}
+		/*
+		*** int compare(const T *, unsigned) const
+		*** compares the first "count" characters of current string value
+		with the first "count" characters of c_str's value
+		*** for return value, please look at the "string comparison table" table above
+		*/
+		int compare(const T *c_str, unsigned count) const {
+			return compare_n(raw_data, MIN(len, count), c_str, strnlength(c_str, count));
+		}
+		/*
+		*** int compare(const T *, unsigned, unsigned, unsigned, unsigned) const
+		*** compares a substring of current string value with a substring of c_str's value
+		*** parameters:
+			-> c_str		- C-String which substring is compared with a substring of current value
+			-> s1pos		- starting position of current value's substring 
+			-> s1count		- length of current value's substring
+			-> s2pos		- starting position of c_str's substring
+			-> s2count		- length of c_str's substring
+		*** both substrings are clipped to the end of their string
+		*** for return value, please look at the "string comparison table" table above
+		*/
+		int compare(const T *c_str, unsigned s1pos, unsigned s1count, unsigned s2pos, unsigned s2count) const {
+			clip(len, s1pos, s1count);
+			clip(strlength<T>(c_str), s2pos, s2count);
+			return compare_n(raw_data + s1pos, s1count, c_str + s2pos, s2count);
+		}
+
+		/*
+		*** int icompare(const string_base<T> &) const
+		*** int icompare(const std_string &) const
+		*** int icompare(const T *) const
+		*** like compare(), but ASCII letters compare as their lower case 
+		(the order of strcasecmp() in the "C" locale), other code units by value
+		*** folds inside the SIMD mismatch search, nothing is copied
+		*** Added with Version 1.9
+		*/
+		int icompare(const string_base &str) const { return icompare_n(raw_data, len, str.raw_data, str.len); }
+#ifdef STR_USE_BINDINGS
+		int icompare(const std_string &str) const { return icompare_n(raw_data, len, str.data(), (unsigned)str.length()); }
+#endif
+		int icompare(const T *c_str) const { return icompare_n(raw_data, len, c_str, strnlength(c_str, len + 1)); }
+		/*
+		*** bool iequals(const string_base<T> &) const
+		*** bool iequals(const std_string &) const
+		*** bool iequals(const T *) const
+		*** checks whether both values are equal regardless of the case of ASCII 
+		letters (see icompare()), different lengths never compare their chars
+		*** Added with Version 1.9
+		*/
+		bool iequals(const string_base &str) const { return iequal_n(raw_data, len, str.raw_data, str.len); }
+#ifdef STR_USE_BINDINGS
+		bool iequals(const std_string &str) const { return iequal_n(raw_data, len, str.data(), (unsigned)str.length()); }
+#endif
+		bool iequals(const T *c_str) const { return iequal_n(raw_data, len, c_str, strnlength(c_str, len + 1)); }
+
+		/*
+		*** string_view_base<T> view(unsigned, unsigned) const
+		*** returns a view of the substring starting at position "start" with a 
+		length of "count" (clipped to the end of the string), without copying
+		*** the view becomes invalid once this string is modified or destroyed
+		*** Added with Version 1.9
+		*/
+		string_view_base<T> view(unsigned start = 0U, unsigned count = ~0U) const {
+			clip(len, start, count);
+			return string_view_base<T>(raw_data + start, count);
+		}
+		/*
+		*** splitter<T> split(const T &, split_mode, unsigned) const
+		*** splitter<T> split(const T *, split_mode, unsigned) const
+		*** splitter<T> split(const string_view_base<T> &, split_mode, unsigned) const
+		*** splitter<T> split_any(const T *, split_mode, unsigned) const
+		*** splitter<T> split_any(const string_view_base<T> &, split_mode, unsigned) const
+		*** lazy tokenizer over this string: split() separates at a char or at a 
+		string (a C-String or a view), split_any() at every char of a set
+		*** tokens are views, nothing is copied or allocated (see splitter<T>)
+			for (str::string_view t : s.split(',', str::split_skip_empty)) ...
+		*** at most "max_splits" splits are done, the rest is the last token
+		*** the splitter becomes invalid once this string is modified or destroyed
+		*** Added with Version 1.9
+		*/
+		splitter<T> split(const T &delim, split_mode mode = split_keep_empty, unsigned max_splits = ~0U) const {
+			return splitter<T>(raw_data, len, delim, mode, max_splits);
+		}
+		splitter<T> split(const T *delim, split_mode mode = split_keep_empty, unsigned max_splits = ~0U) const {
+			return splitter<T>(raw_data, len, delim, strlength<T>(delim), mode, max_splits);
+		}
+		splitter<T> split(const string_view_base<T> &delim, split_mode mode = split_keep_empty, unsigned max_splits = ~0U) const {
+			return splitter<T>(raw_data, len, delim.data(), delim.length(), mode, max_splits);
+		}
+		splitter<T> split_any(const T *set, split_mode mode = split_keep_empty, unsigned max_splits = ~0U) const {
+			return splitter<T>(raw_data, len, set, strlength<T>(set), mode, max_splits, true);
+		}
+		splitter<T> split_any(const string_view_base<T> &set, split_mode mode = split_keep_empty, unsigned max_splits = ~0U) const {
+			return splitter<T>(raw_data, len, set.data(), set.length(), mode, max_splits, true);
+		}
+
+		/*
+		*** _ull_ hash(void) const
+		*** returns the 64 bit hash value of current string value (see str::hash_bytes())
+		*** equal values of the same char type have equal hash values, 
+		independent of allocator and growth policy
+		*** with STR_CACHEHASH defined the value is computed only once and kept 
+		until the string is modified (the cache is not synchronized, so don't 
+		call hash() of one object from several threads at the same time then; 
+		writes through pointers and references taken before the call are not noticed)
+		*** Added with Version 1.9
+		*/
+		_ull_ hash() const {
+#ifdef STR_CACHEHASH
+			if (!hcache.valid) {
+				hcache.value = hash_bytes(raw_data, len * sizeof(T));
+				hcache.valid = true;
+			}
+			return hcache.value;
+#else
+			return hash_bytes(raw_data, len * sizeof(T));
+#endif
+		}
+		/*
+		*** _ull_ ihash(void) const
+		*** case-insensitive hash value matching iequals(): the hash() of the 
+		value with its ASCII letters lowered (see str::ihash_chars()), computed 
+		without a copy and never cached
+		*** together with str::case_insensitive_hash and str::case_insensitive_equal 
+		it backs case-insensitive hash maps
+		*** Added with Version 1.9
+		*/
+		_ull_ ihash() const { return ihash_chars(raw_data, len); }
+
+		/*
+		*** unsigned find(const string_base<T> &, unsigned = 0U)
+		*** returns position of the first occurrence of needle's value in current string value 
+		*** "pos" is the first position which should be considered as the beginning of the seeked string
+		*** does nothing if 
+			-> current string's length == 0
+			-> current string's length is less than needle's length
+			-> needle's length == 0
+		*** returns position of first occurence of needle's value or string's length if it has not been found
+		*** Version 1.9: linear worst case, SIMD filter for short needles and 
+		Two-Way for long ones (see simd::find_str()), const now
+		*/
+		unsigned find(const string_base &needle, unsigned pos = 0U) const {
+			return find_n(needle.raw_data, needle.len, pos, len);
+		}
+#ifdef STR_USE_BINDINGS
+		/*
+		*** unsigned find(const std_string &, unsigned = 0U)
+		*** returns position of the first occurrence of needle's value in current string value
+		*** "pos" is the first position which should be considered as the beginning of the seeked string
+		*** does nothing if
+			-> current string's length == 0
+			-> current string's length is less than needle's length
+			-> needle's length == 0
+		*** returns position of first occurence of needle's value or string's length if it has not been found
+		*** Added with Version 1.4
+		*** Version 1.9: uses needle's stored length, const now
+		*/
+		unsigned find(const std_string &needle, unsigned pos = 0U) const {
+			return find_n(needle.c_str(), (unsigned)needle.length(), pos, len);
+		}
+#endif
+		/*
+		*** unsigned find(const T *, unsigned = 0U)
+		*** returns position of the first occurrence of needle's value in current string value 
+		*** "pos" is the first position which should be considered as the beginning of the seeked string
+		*** does nothing if 
+			-> current string's length == 0
+			-> current string's length is less than needle's length
+			-> needle's length == 0
+		*** returns position of first occurrence of needle's value or string's length if it has not been found
+		*** Version 1.9: linear worst case, SIMD filter for short needles and 
+		Two-Way for long ones (see simd::find_str()), const now
+		*/
+		unsigned find(const T *needle, unsigned pos = 0U) const {
+			return find_n(needle, strlength<T>(needle), pos, len);
+		}
+		/*
+		*** unsigned find(const T *, unsigned, unsigned)
+		*** returns position of the first occurrence of needle's 
+		value in a substring of current string value starting with 
+		position "start" with a length of "count"
+		*** does nothing if 
+			-> current string's length == 0
+			-> current string's length is less than needle's length
+			-> needle's length == 0
+		*** returns position of needle's start within that substring, 
+		or string's length if it has not been found within that substring
+		*** Version 1.9: linear worst case, SIMD filter for short needles and 
+		Two-Way for long ones (see simd::find_str()), const now
+		*/
+		unsigned find(const T *needle, unsigned pos, unsigned count) const {
+			return find_n(needle, strlength<T>(needle), pos, count);
+		}
+		/*
+		*** unsigned find(const T &, unsigned = 0U)
+		*** returns position of the first occurrence of needle's value in current string value
+		*** "pos" is the first position which should be considered as the seeked character
+		*** returns position of first occurrence, or string's length if it has not been found
+		*** Version 1.9: uses SIMD kernels (SSE2 / AVX2) and is const now
+		*/
+		unsigned find(const T &needle, unsigned pos = 0U) const {
+			if (pos >= len) return len;
+			return pos + simd::find_char(raw_data + pos, len - pos, needle);
+		}
+		/*
+		*** unsigned find(const T &, unsigned, unsigned)
+		*** returns position of the first occurrence of needle's 
+		value in a substring of current string value starting with 
+		position "start" with a length of "count"
+		*** returns string's length if
+			-> needle's value has not been found within that substring
+			-> string's length is less than ("pos" + "count")
+		*** if it has been found, it returns position of its first occurrence
+		*** Version 1.9: uses SIMD kernels (SSE2 / AVX2) and is const now
+		*/
+		unsigned find(const T &needle, unsigned pos, unsigned count) const {
+			if (len < (pos + count)) return len;
+			unsigned i = simd::find_char(raw_data + pos, count, needle);
+			return (i == count) ? len : (pos + i);
+		}
+		/*
+		*** unsigned rfind(const T &)
+		*** returns position of the last occurrence of needle's value in current string value
+		*** returns string's length if it has not been found
+		*** uses SIMD kernels (SSE2 / AVX2)
+		*** Added with Version 1.9
+		*/
+		unsigned rfind(const T &needle) const {
+			return simd::rfind_char(raw_data, len, needle);
+		}
+		/*
+		*** unsigned rfind(const T &, unsigned, unsigned)
+		*** returns position of the last occurrence of needle's 
+		value in a substring of current string value starting with 
+		position "pos" with a length of "count"
+		*** returns string's length if
+			-> needle's value has not been found within that substring
+			-> string's length is less than ("pos" + "count")
+		*** uses SIMD kernels (SSE2 / AVX2)
+		*** Added with Version 1.9
+		*/
+		unsigned rfind(const T &needle, unsigned pos, unsigned count) const {
+			if (len < (pos + count)) return len;
+			unsigned i = simd::rfind_char(raw_data + pos, count, needle);
+			return (i == count) ? len : (pos + i);
+		}
+
+		/*
+		*** unsigned ifind(const string_base<T> &, unsigned = 0U) const
+		*** unsigned ifind(const std_string &, unsigned = 0U) const
+		*** unsigned ifind(const T *, unsigned = 0U) const
+		*** unsigned ifind(const T &, unsigned = 0U) const
+		*** like find(), but ASCII letters match regardless of their case 
+		("Content-Type" is found in "content-type: text/html")
+		*** case is folded inside the SIMD kernels, nothing is copied or lowered 
+		beforehand; linear worst case like find() (see simd::ifind_str())
+		*** non-ASCII code units have to match exactly (no locale, no Unicode 
+		case mapping, see simd::fold())
+		*** returns the position of the first match, or string's length if it has not been found
+		*** Added with Version 1.9
+		*/
+		unsigned ifind(const string_base &needle, unsigned pos = 0U) const {
+			return ifind_n(needle.raw_data, needle.len, pos);
+		}
+#ifdef STR_USE_BINDINGS
+		unsigned ifind(const std_string &needle, unsigned pos = 0U) const {
+			return ifind_n(needle.data(), (unsigned)needle.length(), pos);
+		}
+#endif
+		unsigned ifind(const T *needle, unsigned pos = 0U) const {
+			return ifind_n(needle, strlength<T>(needle), pos);
+		}
+		unsigned ifind(const T &needle, unsigned pos = 0U) const {
+			if (pos >= len) return len;
+			return pos + simd::ifind_char(raw_data + pos, len - pos, needle);
+		}
+
+		/*
+		*** string_base<T> &replace(unsigned, const T &)
+		*** replaces character at position "pos" with replace's value
+		*** does nothing if 
+			-> Given "pos" is greater than highest index of current string value
+		*** returns (eventually modified) *this object
+		*/
+		string_base &replace(unsigned pos, const T &replace) {
+			if (pos > (len - 1)) return (*this);
+			touch();
+			raw_data[pos] = replace;
+			return *this;
+		}
+		/*
+		*** string_base<T> &replace(const string_base<T> &, unsigned, unsigned)
+		*** replaces a substring of current string value (starting at position 
+		"start" with a length of "count") with replace's value
+		*** returns (modified) *this object
+		*/
+		string_base &replace(const string_base &replace, unsigned start, unsigned count) {
+			if (this == &replace) {
+				this->replace(string_base(replace), start, count);
+				return (*this);
+			}
+			if (start >= len || len < (start + count)) return (*this);
+			erase(start, count);
+			insert(replace, start);
+			return (*this);
+		}
+#ifdef STR_USE_BINDINGS
+		/*
+		*** string_base<T> &replace(const std_string &, unsigned, unsigned)
+		*** replaces a substring of current string value (starting at position
+		"start" with a length of "count") with replace's value
+		*** returns (modified) *this object
+		*** Added with Version 1.4
+		*/
+		string_base &replace(const std_string &replace, unsigned start, unsigned count) {
+			if (start >= len || len < (start + count)) return (*this);
+			erase(start, count);
+			insert(replace.c_str(), start);
+			return (*this);
+		}
+#endif
+		/*
+		*** string_base<T> &replace(const T *, unsigned, unsigned)
+		*** replaces a substring of current string value (starting at position 
+		"start" with a length of "count") with replace's value
+		*** does nothing if
+			-> given "start" is greater or equal to current string's length
+			-> current string's length is less than ("start" + "count")
+		*** return (eventually modified) *this object
+		*/
+		string_base &replace(const T *replace, unsigned start, unsigned count) {
+			if (start >= len || len < (start + count)) return (*this);
+			erase(start, count);
+			insert(replace, start);
+			return (*this);
+		}
+		/*
+		*** string_base<T> &replace(const string_base<T> &, const string_base<T> &)
+		*** replaces element's value in current string (if found in current string value) with replace's value
+		*** does nothing if 
+			-> current string value equals to replace's value
+			-> element's value has not been found in current string value
+		*** returns (eventually modified) *this object
+		*/
+		string_base &replace(const string_base &element, const string_base &replace) {
+			if (this == &replace) return (*this);
+			if (this == &element) {
+				this->replace(string_base(element), replace);
+				return (*this);
+			}
+			unsigned pos = find(element, 0);
+			if (pos == len) return (*this);
+			erase(pos, element.len);
+			insert(replace, pos);
+			return (*this);
+		}
+#ifdef STR_USE_BINDINGS
+		/*
+		*** string_base<T> &replace(const std_string &, const std_string &)
+		*** replaces element's value in current string (if found in current string value) with replace's value
+		*** does nothing if
+			-> current string value equals to replace's value
+			-> element's value has not been found in current string value
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.4
+		*/
+		string_base &replace(const std_string &element, const std_string &replace) {
+			unsigned pos = find(element, 0);
+			if (pos == len) return (*this);
+			erase(pos, element.length());
+			insert(replace.c_str(), pos);
+			return (*this);
+		}
+#endif
+		/*
+		*** string_base<T> &replace(const T *, const T *)
+		*** replaces element's value in current string (if found in current string value) with replace's value
+		*** does nothing if
+			-> element's value has not been found in current string value
+		*** returns (eventually modified) *this object
+		*/
+		string_base &replace(const T *element, const T *replace) {
+			unsigned l = strlength<T>(element);
+			unsigned pos = find_n(element, l, 0, len);
+			if (pos == len) return (*this);
+			erase(pos, l);
+			insert(replace, pos);
+			return (*this);
+		}
+		/*
+		*** string_base<T> &replace(const T &, const T &, unsigned)
+		*** replaces element's value in current string with replace's value beginning at index "pos" in current string 
+		*** does nothing if
+			-> Given index ("pos") is greater or equals to current string's length
+		*** returns (eventually modified) *this object
+		*/
+		string_base &replace(const T &element, const T &replace, unsigned pos = 0U) {
+			if (pos >= len) return (*this);
+			unsigned i = simd::find_char(raw_data + pos, len - pos, element);
+			if (i == len - pos) return (*this);
+			touch();
+			simd::replace_char(raw_data + pos + i, len - pos - i, element, replace);
+			return (*this);
+		}
+		/*
+		*** string_base<T> &replace(const T &, const T &, unsigned, unsigned)
+		*** replaces element's value in current string with replace's value 
+		in substring of current string starting at position "pos" with a length of "count"
+		*** does nothing if 
+			-> Given index ("pos") is greater or equals to current string's length
+			-> current string's length is less than ("start" + "count")
+		*** returns (eventually modified) *this object
+		*/
+		string_base &replace(const T &element, const T &replace, unsigned pos, unsigned count) {
+			if (pos >= len || len < (pos + count)) return (*this);
+			unsigned i = simd::find_char(raw_data + pos, count, element);
+			if (i == count) return (*this);
+			touch();
+			simd::replace_char(raw_data + pos + i, count - i, element, replace);
+			return (*this);
+		}
+
+		/*
+		*** string_base<T> &replace_all(const string_base<T> &, const string_base<T> &)
+		*** replaces every (non-overlapping) occurrence of element's value with replace's value
+		*** the string is edited in place if both have the same length, 
+		otherwise the result is built in one forward pass with at most one reallocation
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.9
+		*/
+		string_base &replace_all(const string_base &element, const string_base &replace) {
+			return replace_all_n(element.raw_data, element.len, replace.raw_data, replace.len);
+		}
+#ifdef STR_USE_BINDINGS
+		/*
+		*** string_base<T> &replace_all(const std_string &, const std_string &)
+		*** replaces every (non-overlapping) occurrence of element's value with replace's value
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.9
+		*/
+		string_base &replace_all(const std_string &element, const std_string &replace) {
+			return replace_all_n(element.c_str(), (unsigned)element.length(), replace.c_str(), (unsigned)replace.length());
+		}
+#endif
+		/*
+		*** string_base<T> &replace_all(const T *, const T *)
+		*** replaces every (non-overlapping) occurrence of element's value with replace's value
+		*** returns (eventually modified) *this object
+		*** Added with Version 1.9
+		*/
+		string_base &replace_all(const T *element, const T *replace) {
+			return replace_all_n(element, strlength<T>(element), replace, strlength<T>(replace));
+		}
+		/*
+		*** string_base<T> &replace_all(const T &, const T &)
+		*** replaces every char "element" with "replace" (same as replace(element, replace))
+		*** returns *this object
+		*** Added with Version 1.9
+		*/
+		string_base &replace_all(const T &element, const T &replace) { return this->replace(element, replace, 0U); }
+
+		void push_back(const T &ch) { append(ch); }									/* append ch's value to current value */
+		void push_back(const T *c_str) { append(c_str); }							/* append c_str's value to current value */	
+		void push_back(const string_base &str) { append(str); }					/* append str's value to current value */
+#ifdef STR_USE_BINDINGS
+		void push_back(const std_string &str) { append(str); }						/* append std::basic_string value */
+#endif
+		void push_front(const T &ch) { insert(ch, 0); }								/* insert ch's value at string's front */
+		void push_front(const T *c_str) { insert(c_str, 0); }						/* insert c_str's value at string's front */
+		void push_front(const string_base &str) { insert(str, 0); }				/* insert str's value at string's front */
+#ifdef STR_USE_BINDINGS
+		void push_front(const std_string &str) { insert(str, 0); }					/* insert std::basic_string value at front */
+#endif
+		void pop_back(unsigned count = 1) { erase(len - count, count); }			/* delete last "count" characters from string's back */	
+		void pop_front(unsigned count = 1) { erase(0, count); }						/* delete first "count" characters from string's front */
+		/*
+		*** void reserve(unsigned)
+		*** reallocate string with new size of (cap += count)
+		*** doesn't touch data at all
+		*** Version 1.2: Add null-terminator at the end of array
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*** Version 1.9: don't write null-terminator behind the buffer 
+		*/
+		void reserve(unsigned count = 1) {										
+			if (!count) return;
+			realloc_buf(cap + count);
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+		}
+		/* resize string to "count", fill possible new spaces with '\0' */
+		void resize(unsigned count) { resize(count, (T)'\0'); }
+		/*
+		*** void resize(unsigned, T)
+		*** resize string to a length of "count"
+		*** changes capacity to ("count" + 1), performs reallocation
+		(strings fitting into the inline buffer keep using it)
+		*** if "count" > str.length(), fill new spaces with "ch"
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		void resize(unsigned count, T ch) {
+			if (count == len) return;
+			touch();
+			if (count < len) {
+				len = count;
+				realloc_buf(len + 1);
+#ifdef STR_USE_ASSERTIONS 
+				assert(raw_data != NULL);
+#endif
+				raw_data[len] = 0x00;
+			}
+			else if (count > len) {
+				unsigned o = len; 
+				realloc_buf(count + 1);
+				len = count;
+#ifdef STR_USE_ASSERTIONS 
+				assert(raw_data != NULL);
+#endif
+				for (unsigned i = o; i < count; i++)
+					raw_data[i] = ch;
+				raw_data[len] = 0x00;
+			}
+		}
+		/*
+		*** void swap(string_base<T> &)
+		*** exchange contents of *this and "value"
+		*** Example: 
+			string a = "Pear", b = "Apple";
+			a.swap(b); 
+			// a is now "Apple" and b is now "Pear"
+		*** exchanges buffers, lengths, capacities and allocators in constant time
+		(only the inline buffers are copied, no allocation is performed)
+		*** Version 1.2: fix function
+		*** Version 1.6: replace cleanup() with delete call
+		*** Version 1.9: swap buffers instead of assigning (no allocation)
+		*/
+		void swap(string_base &value) {
+			if (this == &value) return;
+			drop_hash();
+			value.drop_hash();
+			T *a = is_inline() ? NULL : raw_data;
+			T *b = value.is_inline() ? NULL : value.raw_data;
+			T tmp[sso_cap];
+			memcpy(tmp, sso_buf, sizeof(sso_buf));
+			memcpy(sso_buf, value.sso_buf, sizeof(sso_buf));
+			memcpy(value.sso_buf, tmp, sizeof(sso_buf));
+			raw_data = b ? b : sso_buf;
+			value.raw_data = a ? a : value.sso_buf;
+			unsigned l = len; len = value.len; value.len = l;
+			unsigned c = cap; cap = value.cap; value.cap = c;
+			Alloc al = get_alloc(); get_alloc() = value.get_alloc(); value.get_alloc() = al;
+		}
+		/* 
+		*** void reverse()
+		*** reverse string from pos 0 to end
+		*** from: https://www.geeksforgeeks.org/write-a-program-to-reverse-an-array-or-string/
+		*/
+		void reverse() { reverse(0, len - 1); }			
+		/*
+		*** void reverse(unsigned, unsigned)
+		*** reverses string's data from "start" to "end"
+		*** Example:
+			string a = "Hello world!";
+			a.reverse(0, a.length() - 1);
+			// a is now "!dlrow olleH"
+		*** doesn't touch size or capacity
+		*/
+		void reverse(unsigned start, unsigned end) {
+			if (start == end || len < 2 ||
+				end > (len - 1) ||
+				start > (len - 1)) return;
+			touch();
+			while (start < end) {
+				T tmp = raw_data[start];
+				raw_data[start] = raw_data[end];
+				raw_data[end] = tmp;
+				++start, --end;
+			}
+		}
+		/*
+		*** void shrink()
+		*** shrink capacity to fit with len
+		*** performs a reallocation
+		(moves the string back into the inline buffer if it fits)
+		*** doesn't touch string's data
+		*** Version 1.6: Added assertions to make debugging the program easier
+		*/
+		void shrink() {
+			if (cap == (len + 1)) return;
+			realloc_buf(len + 1);
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+			raw_data[len] = 0x00;
+		}
+		/*
+		*** void clear()
+		*** clear string (destroy all chars)
+		*** doesn't touch capacity, performs no reallocation
+		*** sets first char to 0x00
+		*** Version 1.9: keep the buffer instead of reallocating it
+		*/
+		void clear() {
+			unshare();
+			raw_data[0] = 0x00;
+			len = 0;
+		}
+		/*
+		*** void reset()
+		*** set string's allocation state tback to default 
+		*** deallocates heap storage and switches back to the inline buffer
+		*** All data is lost, so only do it when you really want it
+		*/
+		void reset() {
+			drop_hash();
+			free_buf();
+			raw_data = sso_buf;
+			raw_data[0] = 0x00;
+			len = 0; cap = sso_cap;
+		}
+
+#ifdef STR_USE_CLEANUP_FUNCTION
+		/*
+		*** void cleanup()
+		*** custom destructor you can call if you 
+		want to deallocate the memory used by this string object
+		*** this object and all of its members will be invalided after calling this function
+		*** All data is lost when calling this 
+		*** Version 1.1: add this function and remove default destructor
+		*** Version 1.5: define STR_USE_CLEANUP_FUNCTION to enable this function
+		*/
+		void cleanup() {
+			drop_hash();
+			free_buf();
+			/* leave a valid buffer behind, the destructor runs once more */
+			raw_data = sso_buf;
+			delete this;
+		}
+#endif
+
+		/*
+		*********************************************************************************
+		*** OPERATOR OVERLOADS														  ***
+		*********************************************************************************
+		*** The code below defines some functions to convert string to several arithmetic types
+		*** Added in Version 1.4
+		*** supported types:
+			-> long								[stol]
+			-> long long (_ll_)					[stoll]
+			-> unsigned long (_ul_)				[stoul]
+			-> unsigned long long (_ull_)		[stoull]
+			-> float							[stof]
+			-> double							[stod]
+			-> long double (_ld_)				[stold]
+		*** Version 1.9: the chars are parsed in place (no allocation, no read behind the 
+		string, see parse()); leading whitespace, '+' and '-' are accepted like strtol(), 
+		out of range values become the limits of the type, 0 is returned if there's no number
+		*** stof(), stod() and stold() accept hexadecimal floats ("0x1.8p3") like strtod(), 
+		parse() doesn't (it reads the format of std::from_chars())
+		*/
+
+		long stol() const { return sto<long>(); }			/* -> long */
+		_ll_ stoll() const { return sto<_ll_>(); }			/* -> long long */
+		_ul_ stoul() const { return sto<_ul_>(); }			/* -> unsigned long */
+		_ull_ stoull() const { return sto<_ull_>(); }		/* -> unsigned long long */
+		float stof() const { return sto<float>(); }			/* -> float */
+		double stod() const { return sto<double>(); }		/* -> double */
+		_ld_ stold() const { return sto<_ld_>(); }			/* -> long double */
+
+		/*
+		*** parse_result parse(N &, unsigned, unsigned) const
+		*** converts the number starting at "pos" to "value" (any integer type, 
+		float, double or long double) without allocating (see str::parse_number())
+		*** "base" (2 - 36) is used for integers only
+		*** returns the position behind the number (or of the error) 
+		relative to the beginning of the string
+		*** Added with Version 1.9
+		*/
+		template <typename N>
+		parse_result parse(N &value, unsigned pos = 0U, unsigned base = 10U) const {
+			pos = MIN(pos, len);
+			parse_result r = parse_number(raw_data + pos, len - pos, value, base);
+			r.pos += pos;
+			return r;
+		}
+
+		/*
+		*********************************************************************************
+		*** OPERATOR OVERLOADS														  ***
+		*********************************************************************************
+		*** Code below overloads some operators to create some pretty shortcuts of some 
+		function calls
+		*/
+
+		/*
+		*** T &operator [](unsigned)
+		*** return a reference to the char which is at position "pos"
+		*** usage: 
+		***		string a = "Hello world!";
+		***		a[0] = 'Y';						-> change first char of "a" to 'Y'
+		*** can be used to output the character at position "pos" as well
+ 		*/	
+		T &operator [](unsigned pos) { touch(); return raw_data[(pos > (len - 1) ? (len - 1) : pos)]; }
+		/*
+		*** const T &operator [](unsigned) const
+		*** return a reference to the char which is at position "pos"
+		*** can be used to output the character at position "pos" as well
+		*** if current string value is const-qualified, it returns this function when
+		"operator[]" is called outside of the class
+		*/
+		const T &operator [](unsigned pos) const { return raw_data[(pos > (len - 1) ? (len - 1) : pos)]; }
+
+		string_base &operator =(const T &ch) { return assign(ch, 1); }					/* assign ch's value to current string value */
+		string_base &operator =(const T *c_str) { return assign(c_str); }				/* assign c_str's value to current string value */
+		string_base &operator =(const string_base &str) { return assign(str); }		/* assign a str's value to current string value */
+		template <typename L, typename R>
+		string_base &operator =(const concat<T, L, R> &expr) { return assign(expr); }	/* assign a concatenation (operator+) */
+#ifdef STR_CPP11_OR_HIGHER
+		string_base &operator =(string_base &&str) noexcept { return assign(std::move(str)); }	/* move str's value to current string value */
+#endif
+#ifdef STR_USE_BINDINGS
+		string_base &operator =(const std_string &str) { return assign(str); }			/* assign std::basic_string value to current string */
+#endif
+
+		string_base &operator +=(const T &ch) { return append(ch); }						/* append (concatenate) ch's value to current string value */
+		string_base &operator +=(const T *c_str) { return append(c_str); }				/* append c_str's value to current string value */
+		string_base &operator +=(const string_base &str) { return append(str); }		/* append str's value to current string value */
+		template <typename L, typename R>
+		string_base &operator +=(const concat<T, L, R> &expr) { return append(expr); }	/* append a concatenation (operator+) */
+#ifdef STR_USE_BINDINGS
+		string_base &operator +=(const std_string &str) { return append(str); }			/* append std::basic_string value to current string */
+#endif
+
+		string_base &operator -=(const T &ch) { return remove(ch); }						/* remove all characters which equal to ch's value from current string */
+
+		string_base &operator ~() { reverse(); return *this; }							/* operator overload to reverse string */
+
+		bool operator ==(const T *c_str) const { return equal_n(raw_data, len, c_str, strnlength(c_str, len + 1)); }					/* check whether *this == c_str */
+		bool operator ==(const string_base &right) const { return equal_n(raw_data, len, right.raw_data, right.len); }		/* check whether *this == right */
+#ifdef STR_USE_BINDINGS
+		bool operator ==(const std_string &right) const { return equal_n(raw_data, len, right.data(), (unsigned)right.length()); }			/* check whether *this == right (std::basic_string) */
+#endif
+
+		bool operator !=(const T *c_str) const { return !(*this == c_str); }					/* check whether *this != c_str */
+		bool operator !=(const string_base &right) const { return !(*this == right); }		/* check whether *this != right */
+#ifdef STR_USE_BINDINGS
+		bool operator !=(const std_string &right) const { return !(*this == right); }			/* check whether *this != right (std::basic_string) */
+#endif
+
+		/*
+		*********************************************************************
+		*** string comparison table										  ***
+		*********************************************************************
+
+		compared string = *this
+
+		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+		*     * Either the value of the first character that does not		*
+		* <0  * match is lower in the compared string, or all compared		*
+		*     * characters match but the compared string is shorter.		*
+		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+		*     *																*
+		* =0  * They compare equal (so str1 == str2).						*
+		*     *																*
+		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+		*     * Either the value of the first character that does not		*
+		* >0  * match is greater in the compared string, or all compared	*
+		*     * characters match but the compared string is longer.			*
+		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+		* from: http://www.cplusplus.com/reference/string/string/compare/	*														
+		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+		*/
+
+		inline bool operator >(const T *c_str) const { return compare(c_str) > 0; }				/* check whether *this > c_str */
+		inline bool operator <(const T *c_str) const { return compare(c_str) < 0; }				/* check whether *this < c_str */
+		inline bool operator >=(const T *c_str) const { return compare(c_str) >= 0; }				/* check whether *this >= c_str */
+		inline bool operator <=(const T *c_str) const { return compare(c_str) <= 0; }				/* check whether *this <= c_str */
+
+		inline bool operator >(const string_base &str) const { return compare(str) > 0; }		/* check whether *this > str */
+		inline bool operator <(const string_base &str) const { return compare(str) < 0; }		/* check whether *this < str */
+		inline bool operator >=(const string_base &str) const { return compare(str) >= 0; }	/* check whether *this >= str */
+		inline bool operator <=(const string_base &str) const { return compare(str) <= 0; }	/* check whether *this <= str */
+
+#ifdef STR_USE_BINDINGS
+		inline bool operator >(const std_string &str) const { return compare(str) > 0; }			/* check whether *this > str */
+		inline bool operator <(const std_string &str) const { return compare(str) < 0; }			/* check whether *this < str */
+		inline bool operator >=(const std_string &str) const { return compare(str) >= 0; }		/* check whether *this >= str */
+		inline bool operator <=(const std_string &str) const { return compare(str) <= 0; }		/* check whether *this <= str */
+#endif
+
+		/* end of public segment */
+	private:
+		/* number of chars the inline buffer can hold (null-terminator included) */
+		enum { sso_cap = (STR_SSOSIZE / sizeof(T)) ? (STR_SSOSIZE / sizeof(T)) : 1 };
+
+		T *raw_data;		/* actual character (string) storage */
+		unsigned len, cap;	/* len = length of string / cap = capacity of string */
+		T sso_buf[sso_cap];	/* inline buffer, raw_data points here as long as the string fits */
+#ifdef STR_CACHEHASH
+		/* cached hash value, starts invalid in every constructor */
+		struct hash_cache {
+			_ull_ value;
+			bool valid;
+			hash_cache() : value(0), valid(false) {}
+		};
+		mutable hash_cache hcache;
+#endif
+
+		typedef alloc_traits<Alloc> traits;	/* allocator access */
+
+		/* private function converting like strtol() and strtod() (see stol()) */
+		template <typename N>
+		N sto() const {
+			unsigned i = 0;
+			while (i < len && (raw_data[i] == T(' ') || (raw_data[i] >= T('\t') && raw_data[i] <= T('\r')))) i++;
+			bool neg = false;
+			if (i < len && (raw_data[i] == T('+') || raw_data[i] == T('-'))) {
+				neg = (raw_data[i++] == T('-'));
+				if (i < len && raw_data[i] == T('-')) return N(0);
+			}
+			return numeric::sto(raw_data + i, len - i, neg, (N *)0);
+		}
+
+		/* private function invalidating the cached hash value (see STR_CACHEHASH) */
+		void drop_hash() const {
+#ifdef STR_CACHEHASH
+			hcache.valid = false;
+#endif
+		}
+		/*
+		*** private function called right before the value is changed (after 
+		the early returns, so calls changing nothing keep a shared buffer)
+		*** invalidates the cached hash value and detaches a 
+		shared buffer (see STR_CACHEHASH and STR_USE_COW)
+		*/
+		void touch() const {
+			drop_hash();
+#ifdef STR_USE_COW
+			if (is_shared()) const_cast<string_base *>(this)->detach();
+#endif
+		}
+
+		/*
+		*** private function called before the whole value is replaced
+		*** like touch(), but a shared buffer is only released instead of copied
+		(see STR_USE_COW), the string is left empty in its inline buffer then
+		*/
+		void unshare() {
+			drop_hash();
+#ifdef STR_USE_COW
+			if (is_shared()) {
+				heap_free(raw_data, cap);
+				raw_data = sso_buf;
+				raw_data[0] = 0x00;
+				len = 0; cap = sso_cap;
+			}
+#endif
+		}
+
+		Alloc &get_alloc() { return *this; }				/* allocator (private base class) */
+		const Alloc &get_alloc() const { return *this; }	/* allocator (private base class) */
+		/* checks whether the string currently lives in the inline buffer */
+		bool is_inline() const { return raw_data == sso_buf; }
+#ifdef STR_USE_COW
+		/* number of chars in front of every heap buffer holding its reference count */
+		enum { cow_hdr = (sizeof(long) + sizeof(T) - 1) / sizeof(T) };
+		static volatile long *refs_of(T *buf) { return (volatile long *)(void *)(buf - cow_hdr); }
+		/* checks whether other strings use the same heap buffer */
+		bool is_shared() const { return !is_inline() && atomic::load(refs_of(raw_data)) != 1L; }
+		/* checks whether obj's buffer should be shared instead of copied */
+		bool can_share(const string_base &obj) const {
+			return !obj.is_inline() && obj.len * sizeof(T) >= (unsigned)STR_COWSIZE && get_alloc() == obj.get_alloc();
+		}
+		/* use obj's heap buffer as well (the own one must not be allocated) */
+		void share_buf(const string_base &obj) {
+			atomic::increment(refs_of(obj.raw_data));
+			raw_data = obj.raw_data;
+			len = obj.len;
+			cap = obj.cap;
+		}
+		/* copy a shared buffer, so this string owns its buffer alone */
+		void detach() {
+			T *buf = heap_alloc(cap);
+			memcpy(buf, raw_data, (len + 1) * sizeof(T));
+			heap_free(raw_data, cap);
+			raw_data = buf;
+		}
+#else
+		bool is_shared() const { return false; }
+#endif
+		/*
+		*** private functions allocating, freeing and resizing heap buffers
+		of "count" chars through the allocator
+		*** with STR_USE_COW the reference count is placed in front of the 
+		chars, heap_free() only frees the buffer once the last string releases it
+		*/
+		T *heap_alloc(unsigned count) {
+#ifdef STR_USE_COW
+			T *buf = traits::allocate(get_alloc(), count + cow_hdr);
+			if (!buf) return buf;
+			*(long *)(void *)buf = 1L;
+			return buf + cow_hdr;
+#else
+			return traits::allocate(get_alloc(), count);
+#endif
+		}
+		void heap_free(T *buf, unsigned count) {
+#ifdef STR_USE_COW
+			if (atomic::decrement(refs_of(buf)) == 0L)
+				traits::deallocate(get_alloc(), buf - cow_hdr, count + cow_hdr);
+#else
+			traits::deallocate(get_alloc(), buf, count);
+#endif
+		}
+		/* keeps the first "used" chars, the buffer must not be shared */
+		T *heap_realloc(T *buf, unsigned old, unsigned used, unsigned count) {
+#ifdef STR_USE_COW
+			buf = traits::reallocate(get_alloc(), buf - cow_hdr, old + cow_hdr, used + cow_hdr, count + cow_hdr);
+			return buf ? (buf + cow_hdr) : buf;
+#else
+			return traits::reallocate(get_alloc(), buf, old, used, count);
+#endif
+		}
+		/*
+		*** point raw_data to an (uninitialized) buffer of at 
+		least "count" chars, without freeing the old one
+		*** uses the inline buffer if "count" fits into it
+		*/
+		void init_buf(unsigned count) {
+			if (count <= (unsigned)sso_cap) {
+				raw_data = sso_buf;
+				cap = sso_cap;
+				return;
+			}
+			raw_data = heap_alloc(count);
+			cap = count;
+#ifdef STR_USE_ASSERTIONS 
+			assert(raw_data != NULL);
+#endif
+		}
+		/* set up the substring of "l" chars at "s" for the substring constructors */
+		void init_sub(const T *s, unsigned l, unsigned start, unsigned count) {
+			if (start > l) start = 0;
+			if ((start + count) > l) 
+				count = (l - start);
+			len = count;
+			init_buf(len + 1);
+			memcpy(raw_data, s + start, count * sizeof(T));
+			raw_data[len] = 0x00;
+		}
+		/* free heap storage (if any), the inline buffer is part of the object */
+		void free_buf() {
+			if (!is_inline()) 
+				heap_free(raw_data, cap);
+		}
+		/*
+		*** make sure the buffer holds at least "count" chars
+		*** old data is lost if a reallocation is needed
+		*/
+		void discard_buf(unsigned count) {
+			if (count <= cap) return;
+			free_buf();
+			init_buf(count);
+		}
+		/*
+		*** change capacity to "count" chars (at least (len + 1))
+		*** keeps the first (len + 1) chars, switches 
+		between inline buffer and heap if needed
+		*/
+		void realloc_buf(unsigned count) {
+			if (count <= (unsigned)sso_cap) {
+				if (is_inline()) return;
+				memcpy(sso_buf, raw_data, MIN(len + 1, count) * sizeof(T));
+				heap_free(raw_data, cap);
+				raw_data = sso_buf;
+				cap = sso_cap;
+				return;
+			}
+			if (is_inline()) {
+				raw_data = heap_alloc(count);
+#ifdef STR_USE_ASSERTIONS 
+				assert(raw_data != NULL);
+#endif
+				memcpy(raw_data, sso_buf, sizeof(sso_buf));
+			}
+			else if (is_shared()) {	/* never resize a buffer other strings use */
+				T *buf = heap_alloc(count);
+#ifdef STR_USE_ASSERTIONS 
+				assert(buf != NULL);
+#endif
+				memcpy(buf, raw_data, MIN(len + 1, count) * sizeof(T));
+				heap_free(raw_data, cap);
+				raw_data = buf;
+			}
+			else
+				raw_data = heap_realloc(raw_data, cap, len + 1, count);
+			cap = count;
+		}
+		/* checks whether the "count" units at "p" (of any char type) lie within the buffer */
+		template <typename S>
+		bool overlaps_buf(const S *p, unsigned count) const {
+			const char *b = (const char *)raw_data, *q = (const char *)p;
+			return q < b + cap * sizeof(T) && q + count * sizeof(S) > b;
+		}
+		/*
+		*** take over obj's buffer (the own one must not be allocated)
+		*** obj is left as an empty string using its inline buffer
+		*/
+		void take_buf(string_base &obj) {
+			obj.drop_hash();
+			len = obj.len;
+			if (obj.is_inline()) {
+				raw_data = sso_buf;
+				cap = sso_cap;
+				memcpy(sso_buf, obj.sso_buf, sizeof(sso_buf));
+			}
+			else {
+				raw_data = obj.raw_data;
+				cap = obj.cap;
+			}
+			obj.raw_data = obj.sso_buf;
+			obj.raw_data[0] = 0x00;
+			obj.len = 0; obj.cap = sso_cap;
+		}
+		/*
+		*** make sure the buffer holds at least "count" chars, keeps data
+		*** the new capacity is chosen by the growth policy ("Growth")
+		*/
+		void grow_buf(unsigned count) {
+			if (count <= cap) return;
+			realloc_buf(Growth::grow(cap, count, sizeof(T)));
+		}
+		template <typename F>
+		string_base &append_float(F value) {
+			touch();
+			grow_buf(len + 32);	/* sign, 17 digits, point and "e-308" fit */
+			len += numeric::format_float(raw_data + len, value);
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+
+		/*
+		*** private function comparing "a" (length "la") with "b" (length "lb")
+		*** returns <0, 0 or >0 (see "string comparison table"), chars are 
+		compared as values of T, a shorter string is less than a longer one 
+		sharing its whole value as prefix
+		*/
+		static int compare_n(const T *a, unsigned la, const T *b, unsigned lb) {
+			unsigned n = MIN(la, lb);
+			unsigned i = (a == b) ? n : simd::mismatch(a, b, n);
+			if (i < n) return (a[i] < b[i]) ? -1 : 1;
+			return (la < lb) ? -1 : (la > lb) ? 1 : 0;
+		}
+		/*
+		*** private function checking "a" (length "la") and "b" (length "lb") for 
+		equality, different lengths never compare their chars
+		*/
+		static bool equal_n(const T *a, unsigned la, const T *b, unsigned lb) {
+			return la == lb && (a == b || !memcmp(a, b, la * sizeof(T)));
+		}
+		/* private functions like compare_n() and equal_n(), ASCII letters compare without case */
+		static int icompare_n(const T *a, unsigned la, const T *b, unsigned lb) {
+			unsigned n = MIN(la, lb);
+			unsigned i = (a == b) ? n : simd::imismatch(a, b, n);
+			if (i < n) return (simd::fold(a[i]) < simd::fold(b[i])) ? -1 : 1;
+			return (la < lb) ? -1 : (la > lb) ? 1 : 0;
+		}
+		static bool iequal_n(const T *a, unsigned la, const T *b, unsigned lb) {
+			return la == lb && (a == b || simd::imismatch(a, b, la) == la);
+		}
+		/* private function clipping the substring ("pos", "count") to a string of length "l" */
+		static void clip(unsigned l, unsigned &pos, unsigned &count) {
+			if (pos > l) pos = l;
+			if (count > l - pos) count = l - pos;
+		}
+
+		/*
+		*** private function closing the gap after compacting the range of 
+		"count" chars at "start" to "kept" chars (moves the tail)
+		*/
+		void close_gap(unsigned start, unsigned count, unsigned kept) {
+			memmove(raw_data + start + kept, raw_data + start + count, (len - start - count) * sizeof(T));
+			len -= count - kept;
+			raw_data[len] = 0x00;
+		}
+
+		/*
+		*** string_base<T> &replace_all_n(const T *, unsigned, const T *, unsigned)
+		*** shared implementation of the replace_all() overloads, replaces 
+		every "el" (length "m") with "rep" (length "r")
+		*** same lengths: matches are overwritten in place
+		*** shorter replacement: one forward pass compacting the buffer
+		*** longer replacement: counts the matches to get the final length, 
+		grows the buffer once (if needed), moves the value to the end of the 
+		buffer and builds the result in front of it in one forward pass 
+		(the write position never overtakes the read position)
+		*/
+		string_base &replace_all_n(const T *el, unsigned m, const T *rep, unsigned r) {
+			if (!m || m > len) return (*this);
+			if ((el + m > raw_data && el < raw_data + cap) || (rep + r > raw_data && rep < raw_data + cap)) {
+				/* arguments point into this string */
+				string_base e, p;
+				e.resize(m);
+				p.resize(r);
+				memcpy(e.raw_data, el, m * sizeof(T));
+				memcpy(p.raw_data, rep, r * sizeof(T));
+				return replace_all_n(e.raw_data, m, p.raw_data, r);
+			}
+			unsigned p, i = simd::find_str(raw_data, len, el, m);
+			if (i == len) return (*this);
+			touch();	/* detach a shared buffer only once there is a match */
+			if (m == r) {
+				while ((p = simd::find_str(raw_data + i, len - i, el, m)) != len - i) {
+					memcpy(raw_data + i + p, rep, r * sizeof(T));
+					i += p + m;
+				}
+				return (*this);
+			}
+			unsigned off = 0, w = i;	/* the value in front of the first match stays */
+			if (r > m) {
+				unsigned k = 0;
+				while ((p = simd::find_str(raw_data + i, len - i, el, m)) != len - i) {
+					++k;
+					i += p + m;
+				}
+				if (!k) return (*this);
+				off = k * (r - m);
+				grow_buf(len + off + 1);
+				memmove(raw_data + off, raw_data, len * sizeof(T));
+				i = w = 0;
+			}
+			const T *src = raw_data + off;
+			while ((p = simd::find_str(src + i, len - i, el, m)) != len - i) {
+				memmove(raw_data + w, src + i, p * sizeof(T));
+				w += p;
+				memcpy(raw_data + w, rep, r * sizeof(T));
+				w += r;
+				i += p + m;
+			}
+			memmove(raw_data + w, src + i, (len - i) * sizeof(T));
+			len = w + (len - i);
+			raw_data[len] = 0x00;
+			return (*this);
+		}
+
+		/*
+		*** unsigned find_n(const T *, unsigned, unsigned, unsigned) const
+		*** shared implementation of the substring find() overloads
+		*** finds needle "nd" (length "l") starting at one of the positions 
+		[pos, pos + count) (the match may reach behind that range)
+		*** returns its position or len if it has not been found
+		*/
+		unsigned find_n(const T *nd, unsigned l, unsigned pos, unsigned count) const {
+			if (!l || pos >= len || l > (len - pos)) return len;
+			unsigned n = len - pos;
+			if (count < n - l + 1) n = count + l - 1;
+			unsigned r = simd::find_str(raw_data + pos, n, nd, l);
+			return (r == n) ? len : (pos + r);
+		}
+		/* private function like find_n() for ifind(), searching the whole rest of the string */
+		unsigned ifind_n(const T *nd, unsigned l, unsigned pos) const {
+			if (!l || pos >= len || l > (len - pos)) return len;
+			unsigned r = simd::ifind_str(raw_data + pos, len - pos, nd, l);
+			return (r == len - pos) ? len : (pos + r);
+		}
+
+		/*
+		*** private function which is used to get the 
+		length of str's C-String value with value_type "T_"
+		*** only used within the class, not outside 
+		(and also not reachable from outside the class)
+		*/
+		/* private function returning the length of "c_str", but at most "max" */
+		static unsigned strnlength(const T *c_str, unsigned max) {
+			unsigned res = 0;
+			while (res < max && c_str[res]) res++;
+			return res;
+		}
+
+		template <typename T_>
+		static unsigned strlength(const T_ *c_str) {
+			/* return 0 if first char is null-terminator */
+			if (!*c_str) return 0;
+			unsigned res = 0;
+			for (; c_str[res] != 0x00; res++);
+			return res;
+		}
+
+		/*
+		*** private function to fill string buffer
+		*** (uses a memset-like algorithm)
+		*** works with every template type 
+		(memset has problems with char32_t, 
+		therefore I made a similar function. It
+		is currently unused but may be used for other 
+		functions in the future)
+		*** returns dest (parameter 1)
+		*/
+		template <typename T__>
+		static T__ *fill_str(T__ *dest, const T__ &val, _u_ len) {
+			register const T__ *p = dest;
+			while (len-- > 0) *p++ = val;
+			return dest;
+		}
+
+		/* end of private segment */
+	}; /* TEMPLATE CLASS string_base<T> */
+
+	/*
+	*** void swap(string_base<T> &, string_base<T> &)
+	*** exchange contents of "a" and "b" in constant time
+	*** found by argument-dependent lookup (using std::swap; swap(a, b);)
+	*** Added with Version 1.9
+	*/
+	template <typename T, typename Alloc, typename Growth>
+	inline void swap(string_base<T, Alloc, Growth> &a, string_base<T, Alloc, Growth> &b) { a.swap(b); }
+
+	typedef string_base<char> string;				/* normal string (value_type = char) */
+	typedef string_base<wchar_t> wstring;			/* wide string (value_type = wchar_t) */
+/* only add string16 and string32 if C++11 or higher is supported */
+#ifdef STR_CPP11_OR_HIGHER
+	typedef string_base<char16_t> string16;			/* UTF-16 string (value_type = char16_t) */
+	typedef string_base<char32_t> string32;			/* UTF-32 string (value_type = char32_t) */
+#endif
+
+/* strings taking their memory from a str::arena (Added with Version 1.9) */
+	typedef string_base<char, arena_allocator<char> > arena_string;				/* arena string (value_type = char) */
+	typedef string_base<wchar_t, arena_allocator<wchar_t> > arena_wstring;		/* arena wide string (value_type = wchar_t) */
+#ifdef STR_CPP11_OR_HIGHER
+	typedef string_base<char16_t, arena_allocator<char16_t>> arena_string16;	/* arena UTF-16 string (value_type = char16_t) */
+	typedef string_base<char32_t, arena_allocator<char32_t>> arena_string32;	/* arena UTF-32 string (value_type = char32_t) */
+#endif
+
+	/*
+	*** TEMPLATE CLASS string_view_base<T>
+	*** non-owning, read-only reference to a range of chars (pointer + length)
+	*** never allocates; the referenced chars have to outlive the view and 
+	must not be moved (a string_base<T> invalidates its views when it's modified)
+	*** the range is not null-terminated in general, null chars are ordinary chars
+	*** like string_base<T>, the search functions return length() if nothing is found
+	*** Added with Version 1.9
+	*/
+	template <typename T>
+	class string_view_base {
+	public:
+		typedef const T *iterator;					/* iterator type (read-only) */
+		typedef const T *const_iterator;			/* const iterator type */
+		typedef const T &const_reference;			/* const reference type */
+		typedef T value_type;						/* char type */
+#ifdef STR_USE_BINDINGS
+		typedef std::basic_string<T, 
+			std::char_traits<T>, 
+			std::allocator<T> > std_string;			/* std::string typedef */
+#endif
+
+		/*
+		*** constructors
+		*** views of a C-String (up to its null-terminator), of "count" chars at 
+		"data", of a string_base<T> or of a std::basic_string<T>
+		*/
+		string_view_base() : ptr(empty_str()), len(0) {}
+		string_view_base(const T *c_str) : ptr(c_str), len(0) { while (c_str[len]) ++len; }
+		string_view_base(const T *data, unsigned count) : ptr(data), len(count) {}
+		template <typename Alloc, typename Growth>
+		string_view_base(const string_base<T, Alloc, Growth> &str) : ptr(str.c_str()), len(str.length()) {}
+#ifdef STR_USE_BINDINGS
+		string_view_base(const std_string &str) : ptr(str.data()), len((unsigned)str.length()) {}
+#endif
+
+		const T *data() const { return ptr; }						/* returns pointer to the first char (not null-terminated) */
+		unsigned length() const { return len; }						/* returns number of chars */
+		unsigned size() const { return len * sizeof(T); }			/* returns number of bytes */
+		bool empty() const { return !len; }							/* checks whether the view is empty */
+		iterator begin() const { return ptr; }						/* returns iterator to the beginning */
+		iterator end() const { return ptr + len; }					/* returns iterator to the ending */
+		const_reference first() const { return ptr[0]; }			/* returns first char */
+		const_reference last() const { return ptr[len ? len - 1 : 0]; }	/* returns last char */
+		/* returns char at "pos" (the last char if "pos" is out of range, like string_base<T>; the view must not be empty) */
+		const_reference operator [](unsigned pos) const { return ptr[(pos >= len) ? (len ? len - 1 : 0) : pos]; }
+
+		/*
+		*** string_view_base<T> substr(unsigned, unsigned) const
+		*** returns a view of "count" chars starting at "start" (clipped to the view)
+		*/
+		string_view_base substr(unsigned start, unsigned count = ~0U) const {
+			clip(start, count);
+			return string_view_base(ptr + start, count);
+		}
+		/* drop the first / last "count" chars from the view */
+		void remove_prefix(unsigned count) { count = MIN(count, len); ptr += count; len -= count; }
+		void remove_suffix(unsigned count) { len -= MIN(count, len); }
+
+		/*
+		*** unsigned find(const string_view_base<T> &, unsigned) const
+		*** returns position of the first occurrence of needle's value from "pos" on
+		(linear time, see simd::find_str()), length() if it has not been found
+		*** an empty needle is never found
+		*/
+		unsigned find(const string_view_base &needle, unsigned pos = 0U) const {
+			if (!needle.len || pos >= len || needle.len > len - pos) return len;
+			unsigned r = simd::find_str(ptr + pos, len - pos, needle.ptr, needle.len);
+			return (r == len - pos) ? len : (pos + r);
+		}
+		/*
+		*** unsigned find(const T &, unsigned) const
+		*** returns position of the first "ch" from "pos" on, length() if it has not been found
+		*/
+		unsigned find(const T &ch, unsigned pos = 0U) const {
+			if (pos >= len) return len;
+			return pos + simd::find_char(ptr + pos, len - pos, ch);
+		}
+		/*
+		*** unsigned rfind(const T &) const
+		*** returns position of the last "ch", length() if it has not been found
+		*/
+		unsigned rfind(const T &ch) const { return simd::rfind_char(ptr, len, ch); }
+		/*
+		*** unsigned ifind(const string_view_base<T> &, unsigned) const
+		*** unsigned ifind(const T &, unsigned) const
+		*** like find(), ASCII letters match regardless of their case (see string_base<T>::ifind())
+		*/
+		unsigned ifind(const string_view_base &needle, unsigned pos = 0U) const {
+			if (!needle.len || pos >= len || needle.len > len - pos) return len;
+			unsigned r = simd::ifind_str(ptr + pos, len - pos, needle.ptr, needle.len);
+			return (r == len - pos) ? len : (pos + r);
+		}
+		unsigned ifind(const T &ch, unsigned pos = 0U) const {
+			if (pos >= len) return len;
+			return pos + simd::ifind_char(ptr + pos, len - pos, ch);
+		}
+		bool contains(const string_view_base &needle) const { return find(needle) != len; }		/* checks whether needle's value occurs */
+		bool starts_with(const string_view_base &sv) const { return sv.len <= len && !memcmp(ptr, sv.ptr, sv.len * sizeof(T)); }	/* checks the prefix */
+		bool ends_with(const string_view_base &sv) const { return sv.len <= len && !memcmp(ptr + len - sv.len, sv.ptr, sv.len * sizeof(T)); }	/* checks the suffix */
+
+		/*
+		*** lazy tokenizer over the referenced chars (see string_base<T>::split() and splitter<T>)
+		*/
+		splitter<T> split(const T &delim, split_mode mode = split_keep_empty, unsigned max_splits = ~0U) const {
+			return splitter<T>(ptr, len, delim, mode, max_splits);
+		}
+		splitter<T> split(const string_view_base &delim, split_mode mode = split_keep_empty, unsigned max_splits = ~0U) const {
+			return splitter<T>(ptr, len, delim.ptr, delim.len, mode, max_splits);
+		}
+		splitter<T> split_any(const string_view_base &set, split_mode mode = split_keep_empty, unsigned max_splits = ~0U) const {
+			return splitter<T>(ptr, len, set.ptr, set.len, mode, max_splits, true);
+		}
+
+		/*
+		*** int compare(const string_view_base<T> &) const
+		*** compares the referenced chars with those of "sv" 
+		(see the "string comparison table" of string_base<T>)
+		*/
+		int compare(const string_view_base &sv) const {
+			unsigned n = MIN(len, sv.len);
+			unsigned i = (ptr == sv.ptr) ? n : simd::mismatch(ptr, sv.ptr, n);
+			if (i < n) return (ptr[i] < sv.ptr[i]) ? -1 : 1;
+			return (len < sv.len) ? -1 : (len > sv.len) ? 1 : 0;
+		}
+		/*
+		*** int icompare(const string_view_base<T> &) const
+		*** bool iequals(const string_view_base<T> &) const
+		*** compare() and == with ASCII letters compared without case (see string_base<T>::icompare())
+		*/
+		int icompare(const string_view_base &sv) const {
+			unsigned n = MIN(len, sv.len);
+			unsigned i = (ptr == sv.ptr) ? n : simd::imismatch(ptr, sv.ptr, n);
+			if (i < n) return (simd::fold(ptr[i]) < simd::fold(sv.ptr[i])) ? -1 : 1;
+			return (len < sv.len) ? -1 : (len > sv.len) ? 1 : 0;
+		}
+		bool iequals(const string_view_base &sv) const { return len == sv.len && (ptr == sv.ptr || simd::imismatch(ptr, sv.ptr, len) == len); }
+		bool operator ==(const string_view_base &sv) const { return len == sv.len && (ptr == sv.ptr || !memcmp(ptr, sv.ptr, len * sizeof(T))); }
+		bool operator !=(const string_view_base &sv) const { return !(*this == sv); }
+		bool operator <(const string_view_base &sv) const { return compare(sv) < 0; }
+		bool operator >(const string_view_base &sv) const { return compare(sv) > 0; }
+		bool operator <=(const string_view_base &sv) const { return compare(sv) <= 0; }
+		bool operator >=(const string_view_base &sv) const { return compare(sv) >= 0; }
+
+		/*
+		*** _ull_ hash(void) const
+		*** returns the 64 bit hash value of the referenced chars, 
+		equal to the one of a string_base<T> holding the same value
+		*/
+		_ull_ hash() const { return hash_bytes(ptr, len * sizeof(T)); }
+		/* case-insensitive hash value matching iequals() (see string_base<T>::ihash()) */
+		_ull_ ihash() const { return ihash_chars(ptr, len); }
+
+		/*
+		*** parse_result parse(N &, unsigned, unsigned) const
+		*** converts the number starting at "pos" to "value", like string_base<T>::parse()
+		*/
+		template <typename N>
+		parse_result parse(N &value, unsigned pos = 0U, unsigned base = 10U) const {
+			pos = MIN(pos, len);
+			parse_result r = parse_number(ptr + pos, len - pos, value, base);
+			r.pos += pos;
+			return r;
+		}
+
+		/*
+		*** string_view_base<T> next_token(const T &)
+		*** returns the view up to the next "delim" (or the rest of the view) 
+		and drops it and the delimiter from this view
+		*** returns an empty view if this view is empty (check empty() before)
+		*/
+		string_view_base next_token(const T &delim) {
+			unsigned i = find(delim);
+			string_view_base tok(ptr, i);
+			remove_prefix(i < len ? i + 1 : i);
+			return tok;
+		}
+		/*
+		*** string_view_base<T> next_token(const string_view_base<T> &)
+		*** same as above with a separator of several chars
+		*/
+		string_view_base next_token(const string_view_base &sep) {
+			unsigned i = find(sep);
+			string_view_base tok(ptr, i);
+			remove_prefix(i < len ? i + sep.len : i);
+			return tok;
+		}
+
+		/* returns a string_base<T> holding a copy of the referenced chars */
+		string_base<T> to_string() const { return string_base<T>(*this); }
+
+	private:
+		const T *ptr;		/* first referenced char */
+		unsigned len;		/* number of referenced chars */
+
+		/* private function clipping the range ("pos", "count") to the view */
+		void clip(unsigned &pos, unsigned &count) const {
+			if (pos > len) pos = len;
+			if (count > len - pos) count = len - pos;
+		}
+		/* private function returning an empty C-String for default constructed views */
+		static const T *empty_str() {
+			static const T e = T();
+			return &e;
+		}
+	}; /* TEMPLATE CLASS string_view_base<T> */
+
+	typedef string_view_base<char> string_view;				/* view of chars */
+	typedef string_view_base<wchar_t> wstring_view;			/* view of wide chars */
+#ifdef STR_CPP11_OR_HIGHER
+	typedef string_view_base<char16_t> string16_view;		/* view of UTF-16 chars */
+	typedef string_view_base<char32_t> string32_view;		/* view of UTF-32 chars */
+#endif
+
+	/*
+	*** case_insensitive_hash, case_insensitive_equal
+	*** hash and key equality functors for string_base<T> and string_view_base<T> 
+	keys compared by iequals(), e.g. for HTTP header names:
+		std::unordered_map<str::string, int, str::case_insensitive_hash, str::case_insensitive_equal>
+	*** Added with Version 1.9
+	*/
+	struct case_insensitive_hash {
+		template <typename S>
+		size_t operator ()(const S &s) const { return (size_t)s.ihash(); }
+	};
+	struct case_insensitive_equal {
+		template <typename S>
+		bool operator ()(const S &a, const S &b) const { return a.iequals(b); }
+	};
+
+	/*
+	*** TEMPLATE CLASS concat_leaf<T>
+	*** one operand of a concatenation: a range of chars (pointer + length)
+	or a single char kept by value
+	*** Added with Version 1.9
+	*/
+	template <typename T>
+	class concat_leaf {
+	public:
+		concat_leaf(const T *data, unsigned count) : ptr(data), len(count), ch(T()) {}
+		explicit concat_leaf(const T &c) : ptr(NULL), len(1), ch(c) {}
+
+		unsigned length() const { return len; }
+		void write(T *out) const {
+			if (ptr) memcpy(out, ptr, len * sizeof(T));
+			else *out = ch;
+		}
+		bool overlaps(const T *first, const T *last) const { return ptr && ptr < last && ptr + len > first; }
+	private:
+		const T *ptr;
+		unsigned len;
+		T ch;
+	};
+
+	/*
+	*** TEMPLATE CLASS concat<T, L, R>
+	*** lazy concatenation returned by operator+ (L and R are concat_leaf<T>
+	or concat<T, ...>), nothing is copied until it's assigned to a string_base<T>
+	*** the total length is summed up while the expression is built, so the
+	result is allocated exactly once and every part is copied exactly once
+	*** refers to its operands: keep it inside the expression, don't store
+	it ("auto s = a + b;" with temporary operands is a dangling reference)
+	*** Added with Version 1.9
+	*/
+	template <typename T, typename L, typename R>
+	class concat {
+	public:
+		typedef T value_type;
+
+		concat(const L &left, const R &right) : l(left), r(right), len(left.length() + right.length()) {}
+
+		unsigned length() const { return len; }
+		/* copies all parts to "out" (length() chars, no null-terminator) */
+		void write(T *out) const {
+			l.write(out);
+			r.write(out + l.length());
+		}
+		/* checks whether a part refers to chars in [first, last) */
+		bool overlaps(const T *first, const T *last) const { return l.overlaps(first, last) || r.overlaps(first, last); }
+		/* materializes the expression into a string_base<T> */
+		string_base<T> str() const { return string_base<T>(*this); }
+	private:
+		L l;
+		R r;
+		unsigned len;
+	};
+
+	/*
+	*** concat<T, ...> operator +(X, Y)
+	*** lazy concatenation of string_base<T>, const T *, T, std::basic_string<T>,
+	string_view_base<T> and further concatenations (see concat<T, L, R>)
+	*** at least one operand has to be a string_base<T> or a concatenation
+	*** Added with Version 1.9
+	*/
+	template <typename T, typename A, typename G>
+	inline concat_leaf<T> concat_part(const string_base<T, A, G> &str) { return concat_leaf<T>(str.c_str(), str.length()); }
+	template <typename T>
+	inline concat_leaf<T> concat_part(const string_view_base<T> &sv) { return concat_leaf<T>(sv.data(), sv.length()); }
+	template <typename T>
+	inline concat_leaf<T> concat_part(const T *c_str) { unsigned l = 0; while (c_str[l]) ++l; return concat_leaf<T>(c_str, l); }
+#ifdef STR_USE_BINDINGS
+	template <typename T>
+	inline concat_leaf<T> concat_part(const std::basic_string<T> &str) { return concat_leaf<T>(str.data(), (unsigned)str.length()); }
+#endif
+
+	template <typename T, typename A1, typename G1, typename A2, typename G2>
+	inline concat<T, concat_leaf<T>, concat_leaf<T> > operator +(const string_base<T, A1, G1> &a, const string_base<T, A2, G2> &b) {
+		return concat<T, concat_leaf<T>, concat_leaf<T> >(concat_part(a), concat_part(b));
+	}
+	template <typename T, typename A, typename G>
+	inline concat<T, concat_leaf<T>, concat_leaf<T> > operator +(const string_base<T, A, G> &a, const T *b) {
+		return concat<T, concat_leaf<T>, concat_leaf<T> >(concat_part(a), concat_part(b));
+	}
+	template <typename T, typename A, typename G>
+	inline concat<T, concat_leaf<T>, concat_leaf<T> > operator +(const T *a, const string_base<T, A, G> &b) {
+		return concat<T, concat_leaf<T>, concat_leaf<T> >(concat_part(a), concat_part(b));
+	}
+	template <typename T, typename A, typename G>
+	inline concat<T, concat_leaf<T>, concat_leaf<T> > operator +(const string_base<T, A, G> &a, const T &b) {
+		return concat<T, concat_leaf<T>, concat_leaf<T> >(concat_part(a), concat_leaf<T>(b));
+	}
+	template <typename T, typename A, typename G>
+	inline concat<T, concat_leaf<T>, concat_leaf<T> > operator +(const T &a, const string_base<T, A, G> &b) {
+		return concat<T, concat_leaf<T>, concat_leaf<T> >(concat_leaf<T>(a), concat_part(b));
+	}
+	template <typename T, typename A, typename G>
+	inline concat<T, concat_leaf<T>, concat_leaf<T> > operator +(const string_base<T, A, G> &a, const string_view_base<T> &b) {
+		return concat<T, concat_leaf<T>, concat_leaf<T> >(concat_part(a), concat_part(b));
+	}
+	template <typename T, typename A, typename G>
+	inline concat<T, concat_leaf<T>, concat_leaf<T> > operator +(const string_view_base<T> &a, const string_base<T, A, G> &b) {
+		return concat<T, concat_leaf<T>, concat_leaf<T> >(concat_part(a), concat_part(b));
+	}
+#ifdef STR_USE_BINDINGS
+	template <typename T, typename A, typename G>
+	inline concat<T, concat_leaf<T>, concat_leaf<T> > operator +(const string_base<T, A, G> &a, const std::basic_string<T> &b) {
+		return concat<T, concat_leaf<T>, concat_leaf<T> >(concat_part(a), concat_part(b));
+	}
+	template <typename T, typename A, typename G>
+	inline concat<T, concat_leaf<T>, concat_leaf<T> > operator +(const std::basic_string<T> &a, const string_base<T, A, G> &b) {
+		return concat<T, concat_leaf<T>, concat_leaf<T> >(concat_part(a), concat_part(b));
+	}
+#endif
+
+	template <typename T, typename L, typename R, typename A, typename G>
+	inline concat<T, concat<T, L, R>, concat_leaf<T> > operator +(const concat<T, L, R> &a, const string_base<T, A, G> &b) {
+		return concat<T, concat<T, L, R>, concat_leaf<T> >(a, concat_part(b));
+	}
+	template <typename T, typename L, typename R, typename A, typename G>
+	inline concat<T, concat_leaf<T>, concat<T, L, R> > operator +(const string_base<T, A, G> &a, const concat<T, L, R> &b) {
+		return concat<T, concat_leaf<T>, concat<T, L, R> >(concat_part(a), b);
+	}
+	template <typename T, typename L, typename R>
+	inline concat<T, concat<T, L, R>, concat_leaf<T> > operator +(const concat<T, L, R> &a, const T *b) {
+		return concat<T, concat<T, L, R>, concat_leaf<T> >(a, concat_part(b));
+	}
+	template <typename T, typename L, typename R>
+	inline concat<T, concat_leaf<T>, concat<T, L, R> > operator +(const T *a, const concat<T, L, R> &b) {
+		return concat<T, concat_leaf<T>, concat<T, L, R> >(concat_part(a), b);
+	}
+	template <typename T, typename L, typename R>
+	inline concat<T, concat<T, L, R>, concat_leaf<T> > operator +(const concat<T, L, R> &a, const T &b) {
+		return concat<T, concat<T, L, R>, concat_leaf<T> >(a, concat_leaf<T>(b));
+	}
+	template <typename T, typename L, typename R>
+	inline concat<T, concat_leaf<T>, concat<T, L, R> > operator +(const T &a, const concat<T, L, R> &b) {
+		return concat<T, concat_leaf<T>, concat<T, L, R> >(concat_leaf<T>(a), b);
+	}
+	template <typename T, typename L, typename R>
+	inline concat<T, concat<T, L, R>, concat_leaf<T> > operator +(const concat<T, L, R> &a, const string_view_base<T> &b) {
+		return concat<T, concat<T, L, R>, concat_leaf<T> >(a, concat_part(b));
+	}
+	template <typename T, typename L, typename R>
+	inline concat<T, concat_leaf<T>, concat<T, L, R> > operator +(const string_view_base<T> &a, const concat<T, L, R> &b) {
+		return concat<T, concat_leaf<T>, concat<T, L, R> >(concat_part(a), b);
+	}
+#ifdef STR_USE_BINDINGS
+	template <typename T, typename L, typename R>
+	inline concat<T, concat<T, L, R>, concat_leaf<T> > operator +(const concat<T, L, R> &a, const std::basic_string<T> &b) {
+		return concat<T, concat<T, L, R>, concat_leaf<T> >(a, concat_part(b));
+	}
+	template <typename T, typename L, typename R>
+	inline concat<T, concat_leaf<T>, concat<T, L, R> > operator +(const std::basic_string<T> &a, const concat<T, L, R> &b) {
+		return concat<T, concat_leaf<T>, concat<T, L, R> >(concat_part(a), b);
+	}
+#endif
+	template <typename T, typename L1, typename R1, typename L2, typename R2>
+	inline concat<T, concat<T, L1, R1>, concat<T, L2, R2> > operator +(const concat<T, L1, R1> &a, const concat<T, L2, R2> &b) {
+		return concat<T, concat<T, L1, R1>, concat<T, L2, R2> >(a, b);
+	}
+
+	/*
+	*** TEMPLATE CLASS splitter<T>
+	*** lazy tokenizer returned by split() and split_any(): yields the parts 
+	between the delimiters as views (pointer + length), nothing is copied
+	*** delimiters are a single char, any char of a set or a string
+	*** "mode" split_skip_empty drops empty tokens (runs of delimiters and 
+	delimiters at the ends), split_keep_empty keeps them ("a,,b" -> "a", "", "b")
+	*** after "max_splits" splits the rest is returned as last token
+	*** single chars and sets are scanned in SIMD blocks whose delimiter masks 
+	are kept between tokens, so dense delimiters don't rescan anything; sets of 
+	bytes use a nibble lookup (SSSE3), other sets of up to 3 chars compare lane-wise 
+	and larger sets of wide chars are checked per char; strings use simd::find_str()
+	*** refers to the split chars and to the delimiter string / set, both have 
+	to outlive the splitter and its iterators
+	*** Added with Version 1.9
+	*/
+	template <typename T>
+	class splitter {
+	public:
+		/* state of one pass, the splitter itself is never modified by iterating */
+		struct cursor {
+			cursor() : pos(0), splits(0), base(0), mask(0), block(false), done(false) {}
+			unsigned pos;		/* start of the next token */
+			unsigned splits;	/* number of splits done */
+			unsigned base;		/* start of the scanned block */
+			unsigned mask;		/* delimiter mask of the block at "base" (SIMD) */
+			bool block;			/* "base" and "mask" are valid */
+			bool done;			/* no tokens left */
+		};
+
+		splitter(const T *data, unsigned count, T delim, split_mode mode = split_keep_empty, unsigned max_splits = ~0U)
+			: h(data), n(count), kind(by_char), dl(1), skip(mode == split_skip_empty), limit(max_splits), ch(delim), set(NULL, 0), str(NULL) {
+			init();
+		}
+		splitter(const T *data, unsigned count, const T *delim, unsigned delim_len, split_mode mode = split_keep_empty, unsigned max_splits = ~0U)
+			: h(data), n(count), kind(by_string), dl(delim_len), skip(mode == split_skip_empty), limit(max_splits), ch(T()), set(NULL, 0), str(delim) {
+			if (dl == 1) { kind = by_char; ch = delim[0]; }
+			init();
+		}
+		/* tag constructor for split_any() */
+		splitter(const T *data, unsigned count, const T *chars, unsigned chars_len, split_mode mode, unsigned max_splits, bool)
+			: h(data), n(count), kind(by_set), dl(1), skip(mode == split_skip_empty), limit(max_splits), ch(T()), set(chars, chars_len), str(NULL) {
+			if (chars_len == 1) { kind = by_char; ch = chars[0]; }
+			init();
+		}
+
+		/*
+		*** bool next(string_view_base<T> &)
+		*** stores the next token in "token", returns false if there is none
+		*** uses the splitter's own cursor (see reset()), iterators have their own ones
+		*/
+		bool next(string_view_base<T> &token) { return next(cur, token); }
+		/* start over at the first token */
+		void reset() { start(cur); }
+		/* returns the number of tokens (a full pass) */
+		unsigned count() const {
+			cursor c;
+			start(c);
+			string_view_base<T> t;
+			unsigned k = 0;
+			while (next(c, t)) k++;
+			return k;
+		}
+
+		/*
+		*** CLASS iterator
+		*** forward iterator over the tokens, *it is a view of the current token
+		*** for (str::string_view t : s.split(',')) ... works with C++11
+		*/
+		class iterator {
+		public:
+			iterator() : sp(NULL) {}
+			const string_view_base<T> &operator *() const { return tok; }
+			const string_view_base<T> *operator ->() const { return &tok; }
+			iterator &operator ++() { if (!sp->next(c, tok)) sp = NULL; return *this; }
+			iterator operator ++(int) { iterator it(*this); ++*this; return it; }
+			bool operator ==(const iterator &it) const { return sp == it.sp && (!sp || c.pos == it.c.pos); }
+			bool operator !=(const iterator &it) const { return !(*this == it); }
+		private:
+			friend class splitter;
+			const splitter *sp;
+			cursor c;
+			string_view_base<T> tok;
+
+			explicit iterator(const splitter *s) : sp(s) { s->start(c); ++*this; }
+		};
+		iterator begin() const { return iterator(this); }
+		iterator end() const { return iterator(); }
+
+		/* the token at the cursor, false if there is none */
+		bool next(cursor &c, string_view_base<T> &token) const {
+			while (!c.done) {
+				unsigned p = c.pos;
+				if (c.splits >= limit) {
+					if (skip) while (p < n && is_delim(p)) p += dl;
+					c.done = true;
+					token = string_view_base<T>(h + p, n - p);
+					return !(skip && p == n);
+				}
+				unsigned d = find(c, p);
+				if (d >= n) {
+					c.done = true;
+					token = string_view_base<T>(h + p, n - p);
+					return !(skip && p == n);
+				}
+				c.pos = d + dl;
+				if (skip && d == p) continue;
+				c.splits++;
+				token = string_view_base<T>(h + p, d - p);
+				return true;
+			}
+			return false;
+		}
+
+	private:
+		enum { by_char, by_set, by_string };
+
+		const T *h;			/* split chars */
+		unsigned n;			/* number of split chars */
+		int kind;			/* kind of delimiter */
+		unsigned dl;		/* delimiter length */
+		bool skip;			/* skip empty tokens */
+		unsigned limit;		/* maximum number of splits */
+		T ch;				/* delimiter char (by_char) */
+		char_set<T> set;	/* delimiter chars (by_set) */
+		const T *str;		/* delimiter string (by_string) */
+		cursor cur;			/* cursor of next() */
+#ifdef STR_SSSE3
+		__m128i lo, hi;		/* nibble tables of a byte set */
+#endif
+
+		void init() {
+			if (!dl) { kind = by_set; dl = 1; }				/* empty delimiter: no splits */
+			if (kind == by_set && !set.n) limit = 0;
+#ifdef STR_SSSE3
+			if (kind == by_set && sizeof(T) == 1) {
+				unsigned char l[16] = { 0 }, u[16] = { 0 };
+				for (unsigned i = 0; i < 256; i++)
+					if (set.map[i] & 1) ((i < 128) ? l : u)[i & 0x0F] |= (unsigned char)(1U << ((i >> 4) & 7));
+				lo = _mm_loadu_si128((const __m128i *)l);
+				hi = _mm_loadu_si128((const __m128i *)u);
+			}
+#endif
+			start(cur);
+		}
+		void start(cursor &c) const { c = cursor(); }
+		bool is_delim(unsigned p) const {
+			if (kind == by_char) return h[p] == ch;
+			if (kind == by_set) return set(h[p]);
+			return dl <= n - p && !memcmp(h + p, str, dl * sizeof(T));
+		}
+
+		/* position of the first delimiter at or behind "p", n if there is none */
+		unsigned find(cursor &c, unsigned p) const {
+			if (kind == by_string) {
+				unsigned r = simd::find_str(h + p, n - p, str, dl);
+				return (r >= n - p) ? n : (p + r);
+			}
+#if defined(STR_SSE2)
+			if (kind == by_char || vector_set()) {
+				const unsigned step = block_size();
+				if (c.block && p < c.base + step) {	/* rest of the last block */
+					unsigned m = c.mask & (~0U << ((p - c.base) * sizeof(T)));
+					if (m) return c.base + simd::lowest_bit(m) / sizeof(T);
+					p = c.base + step;
+				}
+				c.block = false;
+				unsigned m = 0;
+				if (kind == by_char) {
+#ifdef STR_AVX2
+					const __m256i v = simd::splat256((unsigned)ch, simd::width<sizeof(T)>());
+#else
+					const __m128i v = simd::splat((unsigned)ch, simd::width<sizeof(T)>());
+#endif
+					for (; p + step <= n && !(m = simd::eq_mask(h + p, v)); p += step);
+				}
+#ifdef STR_SSSE3
+				else if (sizeof(T) == 1 && set.n > 3)
+					for (; p + step <= n && !(m = simd::set_mask((const unsigned char *)(h + p), lo, hi)); p += step);
+#endif
+				else {
+					const T *s = set.wide;
+					const __m128i a = simd::splat((unsigned)s[0], simd::width<sizeof(T)>());
+					const __m128i b = simd::splat((unsigned)s[(set.n > 1) ? 1 : 0], simd::width<sizeof(T)>());
+					const __m128i d = simd::splat((unsigned)s[(set.n > 2) ? 2 : 0], simd::width<sizeof(T)>());
+					for (; p + step <= n && !(m = simd::eq_mask(h + p, a) | simd::eq_mask(h + p, b) | simd::eq_mask(h + p, d)); p += step);
+				}
+				if (m) {
+					c.base = p;
+					c.mask = m;
+					c.block = true;
+					return p + simd::lowest_bit(m) / sizeof(T);
+				}
+			}
+#endif
+			if (kind == by_char) {
+				for (; p < n; p++) if (h[p] == ch) return p;
+				return n;
+			}
+			for (; p < n; p++) if (set(h[p])) return p;
+			return n;
+		}
+#ifdef STR_SSE2
+		/* sets of up to 3 chars are compared lane-wise, other sets of bytes looked up by nibbles */
+		bool vector_set() const {
+#ifdef STR_SSSE3
+			if (sizeof(T) == 1) return true;
+#endif
+			return set.n <= 3;
+		}
+		/* chars per SIMD block (single chars use 32 bytes with AVX2) */
+		unsigned block_size() const {
+#ifdef STR_AVX2
+			if (kind == by_char) return 32 / sizeof(T);
+#endif
+			return 16 / sizeof(T);
 		}
+#endif
+	}; /* TEMPLATE CLASS splitter<T> */
 
+	/*
+	*** TEMPLATE CLASS searcher<T>
+	*** precompiled needle for repeated lookups of the same pattern
+	*** the needle is preprocessed once: its two rarest chars are selected and 
+	broadcast into SIMD registers (filter), a skip table is built for builds 
+	without SIMD and the Two-Way factorization is computed (linear worst case)
+	*** a searcher is never modified after construction, so it can be shared by 
+	several threads; copies are cheap (no allocation for needles fitting into 
+	the inline buffer of string_base<T>)
+	*** every function returns the length of the haystack if nothing is found
+	*** Added with Version 1.9
+	*/
+	template <typename T>
+	class searcher {
+	public:
 		/*
-		*** string_base<T> &substr(unsigned, unsigned)
-		*** generates a substring of current string value (starting at position "pos" with a length of "count")
-		*** performs a reallocation, changes size and capacity
-		*** does nothing if
-			-> Given "pos" is greater than highest index of current string value
-			-> substring's length ("count") == 0
-		*** if "start" is greater than str's length, then start = 0
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimizing, using memcpy() now
+		*** constructors
+		*** the needle is copied, it may contain null chars if its length is passed
 		*/
-		string_base<T> &substr(unsigned start, unsigned count) {
-			if (start > (len - 1) || !count) return (*this);
-			if ((start + count) > len)
-				count = (len - start);
-			T *new_data = new T[cap];
-			memcpy(new_data, raw_data + start, count * sizeof(T));
-			this->len = count;
-			new_data[len] = 0x00;
-			delete[] raw_data;
-			raw_data = new_data;
-			return (*this);
-		}
+		searcher(const T *needle) { unsigned l = 0; while (needle[l]) ++l; init(needle, l); }
+		searcher(const T *needle, unsigned len) { init(needle, len); }
+		template <typename Alloc, typename Growth>
+		searcher(const string_base<T, Alloc, Growth> &needle) { init(needle.c_str(), needle.length()); }
+		searcher(const string_view_base<T> &needle) { init(needle.data(), needle.length()); }
 
 		/*
-		*** string_base<T> &remove(const T &)
-		*** removes a specified character value represented by "ch" from whole string
-		*** performs a reallocation, changes size and capacity
-		*** does nothing if
-			-> current string's length == 0
-			-> ch's value == 0x00 (null-terminator)
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimizing, using another remove() overload now
+		*** unsigned length(void)
+		*** returns the length of the needle
 		*/
-		string_base<T> &remove(const T &ch) { remove((T)ch, 0, len); return (*this); }
+		unsigned length(void) const { return m; }
 		/*
-		*** string_base<T> &remove(const T &, unsigned, unsigned)
-		*** removes a specified character represented by ch's value 
-		from a specified range within this string value 
-		(starting with position "start" with a length of "count")
-		*** performs a reallocation, changes size but not capacity
-		*** does nothing if 
-			-> current string's length == 0
-			-> substring's length ("count") == 0
-			-> ch's value == 0x00 (null-terminator)
-			-> Given "pos" is greater than highest index of current string value
-		*** returns (eventually modified) *this object
-		*** Version 1.2: Optimizing, using memmove() now
+		*** const T *c_str(void)
+		*** returns the needle
 		*/
-		string_base<T> &remove(const T &ch, unsigned start, unsigned count) {
-			if (!len || !count || !ch || start > (len - 1))
-				return (*this);
-			unsigned rem_c = 0;
-			if ((start + count) > len)
-				count = (len - start);
-			for (unsigned i = start; i < (start + count); i++)
-				if (raw_data[i] == ch) {
-					memmove(raw_data + i, raw_data + i + 1, (len - i) * sizeof(T));
-					++rem_c;
+		const T *c_str(void) const { return nd.c_str(); }
+
+		/*
+		*** unsigned find(const T *, unsigned, unsigned)
+		*** find the needle in the range "h" (length "n"), beginning at "pos"
+		*** returns the index of the first match, or "n"
+		*/
+		unsigned find(const T *h, unsigned n, unsigned pos = 0U) const {
+			if (pos > n || m > n - pos) return n;
+			if (!m) return pos;
+			const T *p = nd.c_str();
+			h += pos;
+			n -= pos;
+			unsigned i = 0, r;
+			if (m == 1) r = simd::find_char(h, n, p[0]);
+			else {
+#ifdef STR_SSE2
+				r = simd::pair_filter(h, n, p, m, i1, i2, v1, v2, i);
+#else
+				r = simd::horspool(h, n, p, m, skip, i);
+#endif
+				if (r == n && m <= n - i) {
+					r = simd::two_way_search<simd::exact_chars>(h + i, n - i, p, m, suffix, period, periodic);
+					r = (r == n - i) ? n : (i + r);
 				}
-			this->len -= rem_c;
-			raw_data[len] = 0x00;
-			return (*this);
+			}
+			return (r == n) ? (n + pos) : (r + pos);
 		}
+		template <typename Alloc, typename Growth>
+		unsigned find(const string_base<T, Alloc, Growth> &h, unsigned pos = 0U) const { return find(h.c_str(), h.length(), pos); }
+		unsigned find(const string_view_base<T> &h, unsigned pos = 0U) const { return find(h.data(), h.length(), pos); }
 
 		/*
-		*********************************************************************
-		*** string comparison table										  ***
-		*********************************************************************
-
-		compared string = *this
-
-		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-		*     * Either the value of the first character that does not		*
-		* <0  * match is lower in the compared string, or all compared		*
-		*     * characters match but the compared string is shorter.		*
-		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-		*     *																*
-		* =0  * They compare equal (so str1 == str2).						*
-		*     *																*
-		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-		*     * Either the value of the first character that does not		*
-		* >0  * match is greater in the compared string, or all compared	*
-		*     * characters match but the compared string is longer.			*
-		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-		* from: http://www.cplusplus.com/reference/string/string/compare/	*																
-		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+		*** bool contains(const T *, unsigned)
+		*** returns true if the needle occurs in the range "h" (length "n")
 		*/
+		bool contains(const T *h, unsigned n) const { return find(h, n) != n; }
+		template <typename Alloc, typename Growth>
+		bool contains(const string_base<T, Alloc, Growth> &h) const { return contains(h.c_str(), h.length()); }
+		bool contains(const string_view_base<T> &h) const { return contains(h.data(), h.length()); }
 
-		/* from: https://stackoverflow.com/questions/34873209/implementation-of-strcmp/34873406 */
 		/*
-		*** int compare(const string_base<T> &) const
-		*** compares current string value with str's value 
-		*** for return value, please look at the "string comparison table" table above
+		*** unsigned count(const T *, unsigned)
+		*** returns the number of non-overlapping occurrences of the needle 
+		in the range "h" (length "n"), an empty needle is never counted
 		*/
-		int compare(const string_base<T> &str) const {
-			if (this == &str) return 0;
-			unsigned i = 0;
-			while (raw_data[i] && raw_data[i] == str.raw_data[i]) ++i;
-			return raw_data[i] - str.raw_data[i];
+		unsigned count(const T *h, unsigned n) const {
+			unsigned c = 0;
+			if (!m) return 0;
+			for (unsigned i = find(h, n); i != n; i = find(h, n, i + m)) ++c;
+			return c;
 		}
+		template <typename Alloc, typename Growth>
+		unsigned count(const string_base<T, Alloc, Growth> &h) const { return count(h.c_str(), h.length()); }
+		unsigned count(const string_view_base<T> &h) const { return count(h.data(), h.length()); }
+
 		/*
-		*** int compare(const string_base<T> &, unsigned, unsigned) const
-		*** compares current string value with a substring of str's value 
-		starting at position "start" with a length of "count"
-		*** for return value, please look at the "string comparison table" table above
+		*** OutputIt find_all(const T *, unsigned, OutputIt)
+		*** writes the indices of all non-overlapping occurrences of the needle 
+		in the range "h" (length "n") to "out" (for example std::back_inserter(vec))
+		*** returns the output iterator behind the last written index
 		*/
-		int compare(const string_base<T> &str, unsigned start, unsigned count) const {
-			if (this == &str && !start &&
-				count == str.len) return 0;
-			unsigned i = 0;
-			while (raw_data[i] && raw_data[i] == str.raw_data[start + i] && count)
-				--count, ++i;
-			return raw_data[i] - str.raw_data[start + i];
+		template <typename OutputIt>
+		OutputIt find_all(const T *h, unsigned n, OutputIt out) const {
+			if (!m) return out;
+			for (unsigned i = find(h, n); i != n; i = find(h, n, i + m)) *out++ = i;
+			return out;
 		}
+		template <typename Alloc, typename Growth, typename OutputIt>
+		OutputIt find_all(const string_base<T, Alloc, Growth> &h, OutputIt out) const { return find_all(h.c_str(), h.length(), out); }
+		template <typename OutputIt>
+		OutputIt find_all(const string_view_base<T> &h, OutputIt out) const { return find_all(h.data(), h.length(), out); }
+
+	private:
+		string_base<T> nd;						/* copy of the needle */
+		unsigned m;								/* length of the needle */
+		unsigned i1, i2;						/* positions of the two rarest chars */
+		unsigned suffix, period;				/* Two-Way factorization */
+		bool periodic;
+		unsigned char skip[256];				/* Horspool skip table (low byte of the char) */
+#ifdef STR_SSE2
+		__m128i v1, v2;							/* nd[i1] and nd[i2] broadcast */
+#endif
+
 		/*
-		*** int compare(const string_base<T> &, unsigned, unsigned, unsigned, unsigned) const
-		*** compares a substring of current string with a substring of str's value
-		*** parameters:
-			-> str			- other string value which substring is compared with a substring of current value
-			-> s1pos		- starting position of current value's substring
-			-> s1count		- length of current value's substring
-			-> s2pos		- starting position of str's substring
-			-> s2count		- length of str's substring
-		*** for return value, please look at the "string comparison table" table above
+		*** private function returning how common the char "c" is in typical 
+		text (higher is more common), used to select the filter chars
 		*/
-		int compare(const string_base<T> &str, unsigned s1pos, unsigned s1count, unsigned s2pos, unsigned s2count) const {
-			if (this == &str && !s1pos && !s2pos &&
-				s1count == len && s2count == str.len)
-				return 0;
-			unsigned i = 0;
-			while (raw_data[s1pos + i] && raw_data[s1pos + i] == str.raw_data[s2pos + i] && s1count && s2count)
-				++i, --s1count, --s2count;
-			return raw_data[s1pos + i] - str.raw_data[s2pos + i];
+		static unsigned rank(T c) {
+			static const char common[] = " etaoinsrhldcumfpgwybvkxjqz";
+			unsigned u = (unsigned)c;
+			if (u >= 0x80) return (sizeof(T) == 1) ? 40 : 0;	/* UTF-8 sequences or beyond ASCII */
+			for (unsigned i = 0; common[i]; ++i)
+				if ((unsigned)common[i] == u) return 255 - i;
+			if (u >= 'A' && u <= 'Z') return 200;
+			if (u >= '0' && u <= '9') return 190;
+			if (u == '.' || u == ',' || u == '\n' || u == '_' || u == '-') return 180;
+			return 100;
 		}
-#ifdef STR_USE_BINDINGS
+
+		/* private function to copy and preprocess the needle */
+		void init(const T *needle, unsigned len) {
+			nd.resize(len);
+			if (len) memcpy(nd.data(), needle, len * sizeof(T));
+			m = len;
+			i1 = i2 = suffix = period = 0;
+			periodic = false;
+			unsigned i;
+			for (i = 0; i < 256; ++i) skip[i] = (unsigned char)MIN(m, 255U);
+			for (i = 0; i + 1 < m; ++i) skip[(unsigned)needle[i] & 0xFF] = (unsigned char)MIN(m - 1 - i, 255U);
+			if (m >= 2) {
+				i2 = 1;
+				if (rank(needle[1]) < rank(needle[0])) { i1 = 1; i2 = 0; }
+				for (i = 2; i < m; ++i) {
+					unsigned r = rank(needle[i]);
+					if (r < rank(needle[i1])) { i2 = i1; i1 = i; }
+					else if (r < rank(needle[i2])) i2 = i;
+				}
+				simd::two_way_prepare<simd::exact_chars>(needle, m, suffix, period, periodic);
+			}
+#ifdef STR_SSE2
+			v1 = simd::splat((unsigned)(m ? needle[i1] : 0), simd::width<sizeof(T)>());
+			v2 = simd::splat((unsigned)(m ? needle[i2] : 0), simd::width<sizeof(T)>());
+#endif
+		}
+	}; /* TEMPLATE CLASS searcher<T> */
+
+	/*
+	*** TEMPLATE CLASS multi_searcher<T>
+	*** finds many needles at once in a single pass over the haystack (Aho-Corasick)
+	*** the automaton is a dense DFA over char classes (chars occurring in no 
+	needle share one class), stored as one contiguous transition table with 
+	premultiplied state offsets; match states are flagged in the lowest bit
+	*** small sets use a SIMD prefilter to skip text in which no needle can start 
+	(Teddy with SSSE3 for char strings, otherwise a compare against up to 3 first chars)
+	*** needles are identified by their index in the constructing sequence, empty 
+	needles never match and duplicates are reported with their first index
+	*** a multi_searcher is never modified by searching, so it can be shared by several threads
+	*** Added with Version 1.9
+	*/
+	template <typename T>
+	class multi_searcher {
+	public:
+		/* a single occurrence of needle "pattern" at "pos" within the haystack */
+		struct match {
+			unsigned pattern;	/* index of the needle */
+			unsigned pos;		/* index of the first char in the haystack */
+			unsigned length;	/* length of the needle */
+		};
+
 		/*
-		*** int compare(const std_string &) const
-		*** compares current string value with str's value
-		*** for return value, please look at the "string comparison table" table above
-		*** Added with Version 1.4
+		*** constructors
+		*** "first" and "last" are iterators to a sequence of string_base<T> or C-strings
 		*/
-		int compare(const std_string &str) const {
-			unsigned i = 0;
-			while (raw_data[i] && raw_data[i] == str.c_str()[i]) ++i;
-			return raw_data[i] - str.c_str()[i];
+		multi_searcher() { init(); build(); }
+		template <typename It>
+		multi_searcher(It first, It last) {
+			init();
+			for (; first != last; ++first) add(*first);
+			build();
 		}
+		multi_searcher(const multi_searcher &obj) { init(); copy(obj); }
+#ifdef STR_CPP11_OR_HIGHER
+		multi_searcher(multi_searcher &&obj) noexcept { init(); swap(obj); }
+		multi_searcher &operator =(multi_searcher &&obj) noexcept { swap(obj); return *this; }
+#endif
+		multi_searcher &operator =(const multi_searcher &obj) {
+			if (this != &obj) { multi_searcher tmp(obj); swap(tmp); }
+			return *this;
+		}
+		~multi_searcher() {
+			free(needles); free(offsets); free(delta); free(info); free(wide);
+		}
+
 		/*
-		*** int compare(const std_string &, unsigned, unsigned) const
-		*** compares current string value with a substring of str's value
-		starting at position "start" with a length of "count"
-		*** for return value, please look at the "string comparison table" table above
-		*** Added with Version 1.4
+		*** void swap(multi_searcher &)
+		*** exchange contents with "obj" in constant time
 		*/
-		int compare(const std_string &str, unsigned start, unsigned count) const {
-			unsigned i = 0;
-			while (raw_data[i] && raw_data[i] == str.c_str()[start + i] && count)
-				--count, ++i;
-			return raw_data[i] - str.c_str()[start + i];
+		void swap(multi_searcher &obj) {
+			char tmp[sizeof(multi_searcher)];
+			memcpy(tmp, (void *)this, sizeof(multi_searcher));
+			memcpy((void *)this, (void *)&obj, sizeof(multi_searcher));
+			memcpy((void *)&obj, tmp, sizeof(multi_searcher));
 		}
+
 		/*
-		*** int compare(const std_string &, unsigned, unsigned, unsigned, unsigned) const
-		*** compares a substring of current string with a substring of str's value
-		*** parameters:
-			-> str			- other string value which substring is compared with a substring of current value
-			-> s1pos		- starting position of current value's substring
-			-> s1count		- length of current value's substring
-			-> s2pos		- starting position of str's substring
-			-> s2count		- length of str's substring
-		*** for return value, please look at the "string comparison table" table above
-		*** Added with Version 1.4
+		*** unsigned size(void)
+		*** returns the number of needles
 		*/
-		int compare(const std_string &str, unsigned s1pos, unsigned s1count, unsigned s2pos, unsigned s2count) const {
-			unsigned i = 0;
-			while (raw_data[s1pos + i] && raw_data[s1pos + i] == str.c_str()[s2pos + i] && s1count && s2count)
-				++i, --s1count, --s2count;
-			return raw_data[s1pos + i] - str.c_str()[s2pos + i];
-		}
-#endif
+		unsigned size(void) const { return count; }
 		/*
-		*** int compare(const T *) const 
-		*** compares current string value with c_str's value 
-		*** for return value, please look at the "string comparison table" table above
+		*** const T *needle(unsigned)
+		*** returns needle "index" (length see needle_length())
 		*/
-		int compare(const T *c_str) const {
-			unsigned i = 0;
-			while (raw_data[i] && raw_data[i] == c_str[i]) ++i;
-			return raw_data[i] - c_str[i];
-		}
+		const T *needle(unsigned index) const { return needles + offsets[index]; }
+		unsigned needle_length(unsigned index) const { return offsets[index + 1] - offsets[index]; }
+
 		/*
-		*** int compare(const T *, unsigned, unsigned) const
-		*** compares current string value with a substring of c_str's value
-		starting at position "start" with a length of "count"
-		*** for return value, please look at the "string comparison table" table above
+		*** match find(const T *, unsigned, unsigned)
+		*** finds the leftmost-longest match in the range "h" (length "n"), beginning at "pos"
+		*** if nothing is found, pos of the returned match is "n" and pattern is size()
 		*/
-		int compare(const T *c_str, unsigned start, unsigned count) const {
-			unsigned i = 0;
-			while (raw_data[i] && raw_data[i] == c_str[start + i] && count)
-				--count, ++i;
-			return raw_data[i] - c_str[start + i];
+		match find(const T *h, unsigned n, unsigned pos = 0U) const {
+			match best = { count, n, 0 };
+			if (pos > n) return best;
+			unsigned v = 0, i = pos;
+			bool pre_on = pre != 0;
+			i = run(h, n, i, v, pre_on);
+			if (!(v & 1)) return best;
+			leftmost(v, i, best);
+			while (i < n && i - info[state(v) * 3 + 2] <= best.pos) {	/* a longer match may still start at best.pos */
+				v = delta[(v >> 1) + cls(h[i++])];
+				if (v & 1) leftmost(v, i, best);
+			}
+			return best;
 		}
+		template <typename Alloc, typename Growth>
+		match find(const string_base<T, Alloc, Growth> &h, unsigned pos = 0U) const { return find(h.c_str(), h.length(), pos); }
+		match find(const string_view_base<T> &h, unsigned pos = 0U) const { return find(h.data(), h.length(), pos); }
+
 		/*
-		*** int compare(const T *, unsigned) const
-		*** compares the first "count" characters of current string value
-		with the first "count" characters of c_str's value
-		*** for return value, please look at the "string comparison table" table above
+		*** match find_first(const T *, unsigned, unsigned)
+		*** finds the match which ends first (the longest one of those ending 
+		at the same position), stops scanning there
+		*** if nothing is found, pos of the returned match is "n" and pattern is size()
 		*/
-		int compare(const T *c_str, unsigned count) const {
-			unsigned i = 0;
-			while (raw_data[i] && raw_data[i] == c_str[i] && count)
-				--count, ++i;
-			return raw_data[i] - c_str[i];
+		match find_first(const T *h, unsigned n, unsigned pos = 0U) const {
+			match m = { count, n, 0 };
+			if (pos > n) return m;
+			unsigned v = 0;
+			bool pre_on = pre != 0;
+			unsigned i = run(h, n, pos, v, pre_on);
+			if (v & 1) {
+				unsigned s = state(v);
+				if (info[s * 3] == npos) s = info[s * 3 + 1];
+				m.pattern = info[s * 3];
+				m.length = info[s * 3 + 2];
+				m.pos = i - m.length;
+			}
+			return m;
 		}
+		template <typename Alloc, typename Growth>
+		match find_first(const string_base<T, Alloc, Growth> &h, unsigned pos = 0U) const { return find_first(h.c_str(), h.length(), pos); }
+		match find_first(const string_view_base<T> &h, unsigned pos = 0U) const { return find_first(h.data(), h.length(), pos); }
+
 		/*
-		*** int compare(const T *, unsigned, unsigned, unsigned, unsigned) const
-		*** compares a substring of current string value with a substring of c_str's value
-		*** parameters:
-			-> c_str		- C-String which substring is compared with a substring of current value
-			-> s1pos		- starting position of current value's substring 
-			-> s1count		- length of current value's substring
-			-> s2pos		- starting position of c_str's substring
-			-> s2count		- length of c_str's substring
-		*** for return value, please look at the "string comparison table" table above
+		*** bool contains(const T *, unsigned)
+		*** returns true if any needle occurs in the range "h" (length "n")
 		*/
-		int compare(const T *c_str, unsigned s1pos, unsigned s1count, unsigned s2pos, unsigned s2count) const {
-			unsigned i = 0;
-			while (raw_data[s1pos + i] && raw_data[s1pos + i] == c_str[s2pos + i] && s1count && s2count)
-				++i, --s1count, --s2count;
-			return raw_data[s1pos + i] - c_str[s2pos + i];
-		}
+		bool contains(const T *h, unsigned n) const { return find_first(h, n).pos != n; }
+		template <typename Alloc, typename Growth>
+		bool contains(const string_base<T, Alloc, Growth> &h) const { return contains(h.c_str(), h.length()); }
+		bool contains(const string_view_base<T> &h) const { return contains(h.data(), h.length()); }
 
 		/*
-		*** unsigned find(const string_base<T> &, unsigned = 0U)
-		*** returns position of the first occurrence of needle's value in current string value 
-		*** "pos" is the first position which should be considered as the beginning of the seeked string
-		*** does nothing if 
-			-> current string's length == 0
-			-> current string's length is less than needle's length
-			-> needle's length == 0
-		*** returns position of first occurence of needle's value or string's length if it has not been found
-		*** implementation is based on this article: https://stackoverflow.com/questions/12784766/check-substring-exists-in-a-string-in-c
-		*/
-		unsigned find(const string_base<T> &needle, unsigned pos = 0U) {
-			unsigned counter = 0, ctr = pos, l = needle.len;
-			if (len < 1 || len < l || l < 1) return len;
-			while (ctr <= (len - l) && l > 0) {
-				if ((raw_data[ctr]) == needle.raw_data[0]) {
-					counter = 0;
-					for (unsigned count = ctr; count < (ctr + l); count++) {
-						if (raw_data[count] == needle.raw_data[counter])
-							++counter;
-						else { counter = 0; break; }
-					}
-					if (counter == l)
-						return ctr;
-				} ++ctr;
+		*** OutputIt find_all(const T *, unsigned, OutputIt)
+		*** writes every (also overlapping) match in the range "h" (length "n") 
+		to "out", ordered by end position, longer matches first
+		*** returns the output iterator behind the last written match
+		*/
+		template <typename OutputIt>
+		OutputIt find_all(const T *h, unsigned n, OutputIt out) const {
+			unsigned v = 0, i = 0;
+			bool pre_on = pre != 0;
+			for (;;) {
+				i = run(h, n, i, v, pre_on);
+				if (!(v & 1)) return out;
+				unsigned s = state(v);
+				if (info[s * 3] == npos) s = info[s * 3 + 1];
+				for (; s; s = info[s * 3 + 1]) {
+					match m = { info[s * 3], i - info[s * 3 + 2], info[s * 3 + 2] };
+					*out++ = m;
+				}
 			}
-			return len;
 		}
-#ifdef STR_USE_BINDINGS
+		template <typename Alloc, typename Growth, typename OutputIt>
+		OutputIt find_all(const string_base<T, Alloc, Growth> &h, OutputIt out) const { return find_all(h.c_str(), h.length(), out); }
+		template <typename OutputIt>
+		OutputIt find_all(const string_view_base<T> &h, OutputIt out) const { return find_all(h.data(), h.length(), out); }
+
+	private:
+		enum { npos = ~0U, teddy_max = 64 };
+
+		T *needles;					/* all needles back to back */
+		unsigned *offsets;			/* needle i is needles[offsets[i]] to needles[offsets[i + 1]] */
+		unsigned count, total;		/* number of needles, sum of their lengths */
+		unsigned *delta;			/* transitions, delta[row + class] = 2 * next row + is match state */
+		unsigned *info;				/* per state: needle ending here (or npos), next match state on the suffix chain (0 if none), depth */
+		unsigned states, classes;
+		unsigned char bcls[256];	/* class of chars below 256 */
+		unsigned *wide;				/* sorted pairs (char, class) for chars from 256 on */
+		unsigned nwide;
+		unsigned pre;				/* prefilter: 0 none, 1 first chars, 2 Teddy */
+		T first[3];					/* distinct first chars of the needles (pre == 1) */
+		unsigned nfirst;
+		unsigned char lo[48], hi[48];	/* Teddy nibble masks for 3 positions (pre == 2) */
+		unsigned tk;				/* number of positions checked by Teddy */
+
+		/* private function returning the state index of transition value "v" */
+		unsigned state(unsigned v) const { return (v >> 1) / classes; }
+
+		/* private function returning the char class of "c" */
+		unsigned cls(T c) const {
+			unsigned u = (sizeof(T) == 1) ? ((unsigned)c & 0xFF) : (unsigned)c;
+			if (u < 256) return bcls[u];
+			unsigned l = 0, r = nwide;
+			while (l < r) {
+				unsigned mid = (l + r) / 2;
+				if (wide[mid * 2] < u) l = mid + 1;
+				else r = mid;
+			}
+			return (l < nwide && wide[l * 2] == u) ? wide[l * 2 + 1] : 0;
+		}
+
+		/* private function updating "best" with the matches of state "v" ending at "i" */
+		void leftmost(unsigned v, unsigned i, match &best) const {
+			unsigned s = state(v);
+			if (info[s * 3] == npos) s = info[s * 3 + 1];
+			/* the first needle of the chain is the longest one */
+			unsigned l = info[s * 3 + 2];
+			if (i - l < best.pos || (i - l == best.pos && l > best.length)) {
+				best.pattern = info[s * 3];
+				best.pos = i - l;
+				best.length = l;
+			}
+		}
+
 		/*
-		*** unsigned find(const std_string &, unsigned = 0U)
-		*** returns position of the first occurrence of needle's value in current string value
-		*** "pos" is the first position which should be considered as the beginning of the seeked string
-		*** does nothing if
-			-> current string's length == 0
-			-> current string's length is less than needle's length
-			-> needle's length == 0
-		*** returns position of first occurence of needle's value or string's length if it has not been found
-		*** implementation is based on this article: https://stackoverflow.com/questions/12784766/check-substring-exists-in-a-string-in-c
-		*** Added with Version 1.4
+		*** private function running the automaton from state "v" over h[i] to 
+		h[n - 1] until a match state is reached
+		*** returns the position behind the last consumed char, "v" is flagged 
+		as match state if a match ends there
+		*** the prefilter is turned off ("pre_on") if it hardly skips any chars
 		*/
-		unsigned find(const std_string &needle, unsigned pos = 0U) {
-			return find(needle.c_str(), pos);
+		unsigned run(const T *h, unsigned n, unsigned i, unsigned &v, bool &pre_on) const {
+			unsigned calls = 0, skipped = 0;
+			while (i < n) {
+				if (!v && pre_on) {
+					unsigned p = prefilter(h, n, i);
+					skipped += p - i;
+					if (++calls == 32) {
+						if (skipped < 32 * 8) pre_on = false;
+						calls = skipped = 0;
+					}
+					if ((i = p) == n) break;
+				}
+				v = delta[(v >> 1) + cls(h[i++])];
+				if (v & 1) return i;
+			}
+			v &= ~1U;
+			return n;
+		}
+
+		/* private function returning the first position from "i" on where a needle may start */
+		unsigned prefilter(const T *h, unsigned n, unsigned i) const {
+#ifdef STR_SSSE3
+			if (pre == 2) return i + simd::teddy((const unsigned char *)h + i, n - i, lo, hi, tk);
+#endif
+#ifdef STR_SSE2
+			if (pre == 1) return i + simd::find_any(h + i, n - i, first, nfirst);
+#endif
+			return i;
+		}
+
+		/* private function to reset all members to an empty set of needles */
+		void init() {
+			needles = 0; offsets = 0; delta = 0; info = 0; wide = 0;
+			count = total = states = classes = nwide = pre = nfirst = tk = 0;
+			offsets = (unsigned *)malloc(sizeof(unsigned));
+			offsets[0] = 0;
+		}
+
+		/* private functions to append a needle */
+		template <typename Alloc, typename Growth>
+		void add(const string_base<T, Alloc, Growth> &needle) { add(needle.c_str(), needle.length()); }
+		void add(const string_view_base<T> &needle) { add(needle.data(), needle.length()); }
+		void add(const T *needle) { unsigned l = 0; while (needle[l]) ++l; add(needle, l); }
+		void add(const T *needle, unsigned len) {
+			needles = (T *)realloc(needles, (total + len + 1) * sizeof(T));
+			offsets = (unsigned *)realloc(offsets, (count + 2) * sizeof(unsigned));
+			if (len) memcpy(needles + total, needle, len * sizeof(T));
+			total += len;
+			offsets[++count] = total;
+		}
+
+		/* private function to deep copy "obj" */
+		void copy(const multi_searcher &obj) {
+			unsigned *o = offsets;
+			memcpy((void *)this, (const void *)&obj, sizeof(multi_searcher));
+			offsets = (unsigned *)realloc(o, (count + 1) * sizeof(unsigned));
+			memcpy(offsets, obj.offsets, (count + 1) * sizeof(unsigned));
+			needles = (T *)malloc((total + 1) * sizeof(T));
+			if (total) memcpy(needles, obj.needles, total * sizeof(T));
+			delta = (unsigned *)malloc(states * classes * sizeof(unsigned));
+			memcpy(delta, obj.delta, states * classes * sizeof(unsigned));
+			info = (unsigned *)malloc(states * 3 * sizeof(unsigned));
+			memcpy(info, obj.info, states * 3 * sizeof(unsigned));
+			wide = nwide ? (unsigned *)malloc(nwide * 2 * sizeof(unsigned)) : 0;
+			if (nwide) memcpy(wide, obj.wide, nwide * 2 * sizeof(unsigned));
 		}
+
+		/* private function building the automaton and the prefilter from the needles */
+		void build() {
+			unsigned i, j, k, c;
+			/* char classes, 0 is used for chars occurring in no needle */
+			memset(bcls, 0, sizeof(bcls));
+			classes = 1;
+			for (i = 0; i < total; ++i) {
+				unsigned u = (sizeof(T) == 1) ? ((unsigned)needles[i] & 0xFF) : (unsigned)needles[i];
+				if (u < 256) {
+					if (!bcls[u]) bcls[u] = (unsigned char)classes++;
+					continue;
+				}
+				unsigned l = 0, r = nwide;
+				while (l < r) {
+					unsigned mid = (l + r) / 2;
+					if (wide[mid * 2] < u) l = mid + 1;
+					else r = mid;
+				}
+				if (l < nwide && wide[l * 2] == u) continue;
+				wide = (unsigned *)realloc(wide, (nwide + 1) * 2 * sizeof(unsigned));
+				memmove(wide + (l + 1) * 2, wide + l * 2, (nwide - l) * 2 * sizeof(unsigned));
+				wide[l * 2] = u;
+				wide[l * 2 + 1] = classes++;
+				++nwide;
+			}
+
+			/* trie, at most one state per needle char */
+			unsigned cap = total + 1;
+			delta = (unsigned *)calloc(cap * classes, sizeof(unsigned));
+			info = (unsigned *)malloc(cap * 3 * sizeof(unsigned));
+			info[0] = npos; info[1] = 0; info[2] = 0;
+			states = 1;
+			for (i = 0; i < count; ++i) {
+				if (offsets[i] == offsets[i + 1]) continue;
+				unsigned s = 0;
+				for (j = offsets[i]; j < offsets[i + 1]; ++j) {
+					unsigned &t = delta[s * classes + cls(needles[j])];
+					if (!t) {
+						info[states * 3] = npos;
+						info[states * 3 + 1] = 0;
+						info[states * 3 + 2] = info[s * 3 + 2] + 1;
+						t = states++;
+					}
+					s = t;
+				}
+				if (info[s * 3] == npos) info[s * 3] = i;
+			}
+
+			/* failure links in breadth-first order, completing the DFA */
+			unsigned *fail = (unsigned *)malloc(states * sizeof(unsigned));
+			unsigned *queue = (unsigned *)malloc(states * sizeof(unsigned));
+			unsigned head = 0, tail = 0;
+			fail[0] = 0;
+			queue[tail++] = 0;
+			while (head < tail) {
+				unsigned s = queue[head++];
+				for (c = 0; c < classes; ++c) {
+					unsigned t = delta[s * classes + c];
+					if (!t) {
+						delta[s * classes + c] = s ? delta[fail[s] * classes + c] : 0;
+						continue;
+					}
+					unsigned f = s ? delta[fail[s] * classes + c] : 0;
+					fail[t] = f;
+					info[t * 3 + 1] = (info[f * 3] != npos) ? f : info[f * 3 + 1];
+					queue[tail++] = t;
+				}
+			}
+			free(fail);
+			free(queue);
+
+			/* premultiply and flag match states */
+			for (k = 0; k < states * classes; ++k) {
+				unsigned t = delta[k];
+				delta[k] = ((t * classes) << 1) | ((info[t * 3] != npos || info[t * 3 + 1]) ? 1U : 0U);
+			}
+			if (states < cap) {
+				delta = (unsigned *)realloc(delta, states * classes * sizeof(unsigned));
+				info = (unsigned *)realloc(info, states * 3 * sizeof(unsigned));
+			}
+
+			/* prefilter */
+			unsigned minlen = npos, used = 0;
+			for (i = 0; i < count; ++i) {
+				unsigned l = offsets[i + 1] - offsets[i];
+				if (!l) continue;
+				++used;
+				minlen = MIN(minlen, l);
+				if (nfirst <= 3) {
+					for (j = 0; j < nfirst && first[j] != needles[offsets[i]]; ++j);
+					if (j == nfirst) {
+						if (nfirst < 3) first[nfirst] = needles[offsets[i]];
+						++nfirst;
+					}
+				}
+			}
+			pre = 0;
+			if (!used) return;
+#ifdef STR_SSE2
+			if (nfirst <= 3) { pre = 1; return; }
 #endif
-		/*
-		*** unsigned find(const T *, unsigned = 0U)
-		*** returns position of the first occurrence of needle's value in current string value 
-		*** "pos" is the first position which should be considered as the beginning of the seeked string
-		*** does nothing if 
-			-> current string's length == 0
-			-> current string's length is less than needle's length
-			-> needle's length == 0
-		*** returns position of first occurrence of needle's value or string's length if it has not been found
-		*/
-		unsigned find(const T *needle, unsigned pos = 0U) {
-			unsigned counter = 0, ctr = pos, l = strlength<T>(needle);
-			if (len < 1 || len < l || l < 1) return len;
-			while (ctr <= (len - l) && l > 0) {
-				if ((raw_data[ctr]) == needle[0]) {
-					counter = 0;
-					for (unsigned count = ctr; count < (ctr + l); count++) {
-						if (raw_data[count] == needle[counter])
-							++counter;
-						else { counter = 0; break; }
+			nfirst = 0;
+#ifdef STR_SSSE3
+			if (sizeof(T) == 1 && used <= teddy_max) {
+				tk = MIN(minlen, 3U);
+				memset(lo, 0, sizeof(lo));
+				memset(hi, 0, sizeof(hi));
+				for (i = 0, k = 0; i < count; ++i) {
+					if (offsets[i] == offsets[i + 1]) continue;
+					unsigned char bucket = (unsigned char)(1U << (k++ % 8));
+					for (j = 0; j < tk; ++j) {
+						unsigned char b = (unsigned char)needles[offsets[i] + j];
+						lo[16 * j + (b & 0x0F)] |= bucket;
+						hi[16 * j + (b >> 4)] |= bucket;
 					}
-					if (counter == l)
-						return ctr;
-				} ++ctr;
-			} 
-			return len;
+				}
+				pre = 2;
+			}
+#endif
 		}
+	}; /* TEMPLATE CLASS multi_searcher<T> */
+
+	/*
+	*** TEMPLATE CLASS rope<T>
+	*** string for large documents: a balanced (AVL) tree whose leaves are 
+	immutable string_base<T> chunks of at most STR_ROPECHUNK chars
+	*** insert(), erase(), append() and substr() split and join trees in 
+	O(log n), copying at most the two chunks at the edit positions
+	*** nodes are never modified once built, so copies and substrings share 
+	them (reference counted, copying a rope is O(1)); the counts are not 
+	atomic, don't share nodes of one rope between threads
+	*** Added with Version 1.9
+	*/
+	template <typename T>
+	class rope {
+		struct node;
+	public:
 		/*
-		*** unsigned find(const T *, unsigned, unsigned)
-		*** returns position of the first occurrence of needle's 
-		value in a substring of current string value starting with 
-		position "start" with a length of "count"
-		*** does nothing if 
-			-> current string's length == 0
-			-> current string's length is less than needle's length
-			-> needle's length == 0
-		*** returns position of needle's start within that substring, 
-		or string's length if it has not been found within the substring
-		*/
-		unsigned find(const T *needle, unsigned pos, unsigned count) {
-			unsigned counter = 0, ctr = pos, l = strlength<T>(needle);
-			if (len < 1 || len < l || l < 1) return len;
-			while (ctr <= (len - l) && l > 0 && count) {
-				if ((raw_data[ctr]) == needle[0]) {
-					counter = 0;
-					for (unsigned count = ctr; count < (ctr + l); count++) {
-						if (raw_data[count] == needle[counter])
-							++counter;
-						else { counter = 0; break; }
-					}
-					if (counter == l)
-						return ctr;
-				} ++ctr, --count;
-			} 
-			return len;
+		*** constructors
+		*** the chars are copied into chunks of STR_ROPECHUNK chars
+		*/
+		rope() : root(NULL) {}
+		explicit rope(const string_view_base<T> &sv) : root(build(sv.data(), sv.length())) {}
+		explicit rope(const T *c_str) : root(NULL) { string_view_base<T> sv(c_str); root = build(sv.data(), sv.length()); }
+		rope(const T *data, unsigned count) : root(build(data, count)) {}
+		template <typename Alloc, typename Growth>
+		explicit rope(const string_base<T, Alloc, Growth> &str) : root(build(str.c_str(), str.length())) {}
+		rope(const rope &obj) : root(retain(obj.root)) {}
+#ifdef STR_CPP11_OR_HIGHER
+		rope(rope &&obj) noexcept : root(obj.root) { obj.root = NULL; }
+		rope &operator =(rope &&obj) noexcept { swap(obj); return *this; }
+#endif
+		rope &operator =(const rope &obj) {
+			node *n = retain(obj.root);
+			release(root);
+			root = n;
+			return *this;
 		}
+		~rope() { release(root); }
+
+		void swap(rope &obj) { node *n = root; root = obj.root; obj.root = n; }	/* exchange contents in constant time */
+		unsigned length() const { return root ? root->len : 0; }					/* returns number of chars */
+		bool empty() const { return !root; }										/* checks whether the rope is empty */
+		unsigned depth() const { return root ? root->height : 0; }					/* returns height of the tree */
+
 		/*
-		*** unsigned find(const T &, unsigned = 0U)
-		*** returns position of the first occurrence of needle's value in current string value
-		*** "pos" is the first position which should be considered as the seeked character
-		*** returns position of first occurrence, or string's length if it has not been found
+		*** T at(unsigned) const
+		*** returns the char at "pos" in O(log n) ("pos" has to be less than length())
 		*/
-		unsigned find(const T &needle, unsigned pos = 0U) {
-			for (unsigned i = pos; i < len; i++)
-				if (raw_data[i] == needle)
-					return i;
-			return len;
+		T at(unsigned pos) const {
+			const node *n = root;
+			while (!n->leaf()) {
+				if (pos < n->left->len) n = n->left;
+				else { pos -= n->left->len; n = n->right; }
+			}
+			return n->chunk.c_str()[pos];
 		}
+		T operator [](unsigned pos) const { return at(pos); }
+
 		/*
-		*** unsigned find(const T &, unsigned, unsigned)
-		*** returns position of the first occurrence of needle's 
-		value in a substring of current string value starting with 
-		position "start" with a length of "count"
-		*** returns string's length if
-			-> needle's value has not been found within that substring
-			-> string's length is less than ("pos" + "count")
-		*** if it has been found, it returns position of its first occurrence
+		*** rope<T> &insert(unsigned, const string_view_base<T> &)
+		*** inserts sv's value at "pos" (clipped to the end)
+		*** returns *this object
 		*/
-		unsigned find(const T &needle, unsigned pos, unsigned count) {
-			if (len < (pos + count)) return len;
-			for (unsigned i = pos; i < (pos + count); i++)
-				if (raw_data[i] == needle)
-					return i;
-			return len;
+		rope &insert(unsigned pos, const string_view_base<T> &sv) {
+			return insert_node(pos, build(sv.data(), sv.length()));
 		}
+		/*
+		*** rope<T> &insert(unsigned, const rope<T> &)
+		*** inserts r's value at "pos" (clipped to the end), sharing r's chunks
+		*** returns *this object
+		*/
+		rope &insert(unsigned pos, const rope &r) { return insert_node(pos, retain(r.root)); }
+
+		rope &append(const string_view_base<T> &sv) { root = join(root, build(sv.data(), sv.length())); return *this; }	/* concatenate sv's value */
+		rope &append(const rope &r) { root = join(root, retain(r.root)); return *this; }		/* concatenate r's value, sharing its chunks */
+		rope &operator +=(const string_view_base<T> &sv) { return append(sv); }
+		rope &operator +=(const rope &r) { return append(r); }
 
 		/*
-		*** string_base<T> &replace(unsigned, const T &)
-		*** replaces character at position "pos" with replace's value
-		*** does nothing if 
-			-> Given "pos" is greater than highest index of current string value
-		*** returns (eventually modified) *this object
+		*** rope<T> &erase(unsigned, unsigned)
+		*** erases "count" chars starting at "pos" (clipped to the end)
+		*** returns *this object
 		*/
-		string_base<T> &replace(unsigned pos, const T &replace) {
-			if (pos > (len - 1)) return (*this);
-			raw_data[pos] = replace;
+		rope &erase(unsigned pos, unsigned count) {
+			unsigned l = length();
+			if (pos >= l || !count) return *this;
+			if (count > l - pos) count = l - pos;
+			node *a, *b, *c, *d;
+			split(root, pos, a, b);
+			split(b, count, c, d);
+			release(c);
+			root = join(a, d);
 			return *this;
 		}
+
 		/*
-		*** string_base<T> &replace(const string_base<T> &, unsigned, unsigned)
-		*** replaces a substring of current string value (starting at position 
-		"start" with a length of "count") with replace's value
-		*** returns (modified) *this object
+		*** rope<T> substr(unsigned, unsigned) const
+		*** returns a rope of "count" chars starting at "pos" (clipped to the 
+		end), sharing all chunks except the ones at both ends
 		*/
-		string_base<T> &replace(const string_base<T> &replace, unsigned start, unsigned count) {
-			if (this == &replace) {
-				this->replace(string_base<T>(replace), start, count);
-				return (*this);
-			}
-			if (start >= len || len < (start + count)) return (*this);
-			erase(start, count);
-			insert(replace, start);
-			return (*this);
+		rope substr(unsigned pos, unsigned count = ~0U) const {
+			rope res;
+			unsigned l = length();
+			if (pos >= l || !count) return res;
+			if (count > l - pos) count = l - pos;
+			node *a, *b, *c, *d;
+			split(retain(root), pos, a, b);
+			split(b, count, c, d);
+			release(a);
+			release(d);
+			res.root = c;
+			return res;
 		}
-#ifdef STR_USE_BINDINGS
+
 		/*
-		*** string_base<T> &replace(const std_string &, unsigned, unsigned)
-		*** replaces a substring of current string value (starting at position
-		"start" with a length of "count") with replace's value
-		*** returns (modified) *this object
-		*** Added with Version 1.4
+		*** string_base<T> flatten() const
+		*** returns the value as one contiguous string (exactly one allocation)
 		*/
-		string_base<T> &replace(const std_string &replace, unsigned start, unsigned count) {
-			if (start >= len || len < (start + count)) return (*this);
-			erase(start, count);
-			insert(replace.c_str(), start);
-			return (*this);
+		string_base<T> flatten() const {
+			string_base<T> res(length() + 1);
+			for (chunk_iterator it(*this); !it.done(); ++it) res.append(*it);
+			return res;
 		}
-#endif
+
 		/*
-		*** string_base<T> &replace(const T *, unsigned, unsigned)
-		*** replaces a substring of current string value (starting at position 
-		"start" with a length of "count") with replace's value
-		*** does nothing if
-			-> given "start" is greater or equal to current string's length
-			-> current string's length is less than ("start" + "count")
-		*** return (eventually modified) *this object
+		*** CLASS chunk_iterator
+		*** visits the chunks in order, *it is a view of the current chunk
+		*** may start at the chunk holding a given position (see offset())
+		*** the rope must not be modified while iterating
 		*/
-		string_base<T> &replace(const T *replace, unsigned start, unsigned count) {
-			if (start >= len || len < (start + count)) return (*this);
-			erase(start, count);
-			insert(replace, start);
-			return (*this);
-		}
+		class chunk_iterator {
+		public:
+			explicit chunk_iterator(const rope &r, unsigned pos = 0U) : top(0), cur(NULL), off(0) {
+				if (r.root && pos < r.root->len) descend(r.root, pos);
+			}
+			bool done() const { return !cur; }										/* checks whether all chunks have been visited */
+			string_view_base<T> operator *() const { return cur->chunk; }			/* view of the current chunk */
+			unsigned offset() const { return off; }									/* position of the current chunk's first char */
+			chunk_iterator &operator ++() {
+				off += cur->len;
+				cur = NULL;
+				if (top) descend(stack[--top], 0);
+				return *this;
+			}
+		private:
+			const node *stack[96];	/* right subtrees still to visit (AVL height < 1.45 * log2(n) + 2) */
+			unsigned top;
+			const node *cur;
+			unsigned off;
+
+			void descend(const node *n, unsigned pos) {
+				while (!n->leaf()) {
+					if (pos < n->left->len) { stack[top++] = n->right; n = n->left; }
+					else { pos -= n->left->len; off += n->left->len; n = n->right; }
+				}
+				cur = n;
+			}
+		};
+
 		/*
-		*** string_base<T> &replace(const string_base<T> &, const string_base<T> &)
-		*** replaces element's value in current string (if found in current string value) with replace's value
-		*** does nothing if 
-			-> current string value equals to replace's value
-			-> element's value has not been found in current string value
-		*** returns (eventually modified) *this object
+		*** unsigned find(const string_view_base<T> &, unsigned) const
+		*** returns position of the first occurrence of needle's value from "pos" 
+		on, length() if it has not been found (an empty needle is never found)
+		*** searches every chunk with the SIMD kernels of find(); matches 
+		straddling chunk boundaries are found in a window of the last 
+		(needle length - 1) chars before and the first ones after each boundary
 		*/
-		string_base<T> &replace(const string_base<T> &element, const string_base<T> &replace) {
-			if (this == &replace) return (*this);
-			if (this == &element) {
-				this->replace(string_base<T>(element), replace);
-				return (*this);
+		unsigned find(const string_view_base<T> &needle, unsigned pos = 0U) const {
+			const unsigned l = length(), m = needle.length();
+			if (!m || pos >= l || m > l - pos) return l;
+			const T *nd = needle.data();
+			string_base<T> tail, win;	/* last (m - 1) chars before the current chunk, boundary window */
+			for (chunk_iterator it(*this, pos); !it.done(); ++it) {
+				string_view_base<T> c = *it;
+				unsigned skip = (it.offset() < pos) ? pos - it.offset() : 0;
+				c.remove_prefix(skip);
+				unsigned base = it.offset() + skip;
+				if (tail.length()) {
+					win.assign(tail.view());
+					win.append(c.substr(0, m - 1));
+					unsigned r = simd::find_str(win.c_str(), win.length(), nd, m);
+					if (r < tail.length()) return base - tail.length() + r;
+				}
+				if (c.length() >= m) {
+					unsigned r = simd::find_str(c.data(), c.length(), nd, m);
+					if (r != c.length()) return base + r;
+				}
+				/* keep the last (m - 1) chars */
+				if (c.length() >= m - 1) tail.assign(c.substr(c.length() - (m - 1)));
+				else {
+					tail.append(c);
+					if (tail.length() > m - 1) tail.assign(tail.view(tail.length() - (m - 1)));
+				}
 			}
-			unsigned pos = find(element, 0);
-			if (pos == len) return (*this);
-			erase(pos, element.len);
-			insert(replace, pos);
-			return (*this);
+			return l;
 		}
-#ifdef STR_USE_BINDINGS
 		/*
-		*** string_base<T> &replace(const std_string &, const std_string &)
-		*** replaces element's value in current string (if found in current string value) with replace's value
-		*** does nothing if
-			-> current string value equals to replace's value
-			-> element's value has not been found in current string value
-		*** returns (eventually modified) *this object
-		*** Added with Version 1.4
+		*** unsigned find(const T &, unsigned) const
+		*** returns position of the first "ch" from "pos" on, length() if it has not been found
 		*/
-		string_base<T> &replace(const std_string &element, const std_string &replace) {
-			unsigned pos = find(element, 0);
-			if (pos == len) return (*this);
-			erase(pos, element.length());
-			insert(replace.c_str(), pos);
-			return (*this);
+		unsigned find(const T &ch, unsigned pos = 0U) const {
+			for (chunk_iterator it(*this, pos); !it.done(); ++it) {
+				string_view_base<T> c = *it;
+				unsigned skip = (it.offset() < pos) ? pos - it.offset() : 0;
+				unsigned r = c.find(ch, skip);
+				if (r != c.length()) return it.offset() + r;
+			}
+			return length();
 		}
-#endif
+
+	private:
+		/* tree node, a leaf if "left" is NULL */
+		struct node {
+			unsigned refs;			/* number of owners (ropes and parent nodes) */
+			unsigned height;		/* 1 for leaves */
+			unsigned len;			/* number of chars below this node */
+			node *left, *right;		/* children of inner nodes */
+			string_base<T> chunk;	/* chars of a leaf */
+
+			bool leaf() const { return !left; }
+		};
+
+		node *root;	/* NULL for an empty rope */
+
+		/* private functions to manage node references */
+		static node *retain(node *n) { if (n) ++n->refs; return n; }
+		static void release(node *n) {
+			while (n && !--n->refs) {
+				node *r = n->right;
+				release(n->left);
+				delete n;
+				n = r;
+			}
+		}
+		static unsigned height(const node *n) { return n ? n->height : 0; }
+
+		/* private function creating a leaf of "count" chars at "data" */
+		static node *make_leaf(const T *data, unsigned count) {
+			node *n = new node;
+			n->refs = 1;
+			n->height = 1;
+			n->len = count;
+			n->left = n->right = NULL;
+			n->chunk.assign(string_view_base<T>(data, count));
+			return n;
+		}
+		/* private function creating an inner node, takes over the references of "l" and "r" */
+		static node *make(node *l, node *r) {
+			node *n = new node;
+			n->refs = 1;
+			n->height = MAX(l->height, r->height) + 1;
+			n->len = l->len + r->len;
+			n->left = l;
+			n->right = r;
+			return n;
+		}
+		/* private function building a balanced tree of the "count" chars at "data" */
+		static node *build(const T *data, unsigned count) {
+			if (!count) return NULL;
+			if (count <= (unsigned)STR_ROPECHUNK) return make_leaf(data, count);
+			unsigned chunks = (count + STR_ROPECHUNK - 1) / STR_ROPECHUNK;
+			unsigned mid = (chunks / 2) * STR_ROPECHUNK;
+			return make(build(data, mid), build(data + mid, count - mid));
+		}
+
 		/*
-		*** string_base<T> &replace(const T *, const T *)
-		*** replaces element's value in current string (if found in current string value) with replace's value
-		*** does nothing if
-			-> element's value has not been found in current string value
-		*** returns (eventually modified) *this object
+		*** private function joining "a" and "b" (heights differ by at most 2), 
+		rotating once or twice if needed, takes over both references
 		*/
-		string_base<T> &replace(const T *element, const T *replace) {
-			unsigned pos = find(string_base<T>(element), 0);
-			if (pos == len) return (*this);
-			erase(pos, strlength<T>(element));
-			insert(replace, pos);
-			return (*this);
+		static node *balance(node *a, node *b) {
+			if (a->height > b->height + 1) {
+				node *al = retain(a->left), *ar = retain(a->right);
+				release(a);
+				if (height(al) >= height(ar)) return make(al, make(ar, b));
+				node *arl = retain(ar->left), *arr = retain(ar->right);
+				release(ar);
+				return make(make(al, arl), make(arr, b));
+			}
+			if (b->height > a->height + 1) {
+				node *bl = retain(b->left), *br = retain(b->right);
+				release(b);
+				if (height(br) >= height(bl)) return make(make(a, bl), br);
+				node *bll = retain(bl->left), *blr = retain(bl->right);
+				release(bl);
+				return make(make(a, bll), make(blr, br));
+			}
+			return make(a, b);
 		}
 		/*
-		*** string_base<T> &replace(const T &, const T &, unsigned)
-		*** replaces element's value in current string with replace's value beginning at index "pos" in current string 
-		*** does nothing if
-			-> Given index ("pos") is greater or equals to current string's length
-		*** returns (eventually modified) *this object
+		*** private function concatenating the trees "l" and "r" in O(height difference), 
+		takes over both references
+		*** neighbouring leaves are merged while they fit into one chunk
 		*/
-		string_base<T> &replace(const T &element, const T &replace, unsigned pos = 0U) {
-			if (pos >= len) return (*this);
-			for (unsigned i = pos; i < len; i++)
-				if (raw_data[i] == element)
-					raw_data[i] = replace;
-			return (*this);
+		static node *join(node *l, node *r) {
+			if (!l) return r;
+			if (!r) return l;
+			if (l->leaf() && r->leaf() && l->len + r->len <= (unsigned)STR_ROPECHUNK) {
+				node *n = make_leaf(l->chunk.c_str(), l->len);
+				n->chunk.append(r->chunk);
+				n->len += r->len;
+				release(l);
+				release(r);
+				return n;
+			}
+			if (l->height > r->height + 1) {
+				node *ll = retain(l->left), *lr = retain(l->right);
+				release(l);
+				return balance(ll, join(lr, r));
+			}
+			if (r->height > l->height + 1) {
+				node *rl = retain(r->left), *rr = retain(r->right);
+				release(r);
+				return balance(join(l, rl), rr);
+			}
+			return make(l, r);
 		}
 		/*
-		*** string_base<T> &replace(const T &, const T &, unsigned, unsigned)
-		*** replaces element's value in current string with replace's value 
-		in substring of current string starting at position "pos" with a length of "count"
-		*** does nothing if 
-			-> Given index ("pos") is greater or equals to current string's length
-			-> current string's length is less than ("start" + "count")
-		*** returns (eventually modified) *this object
+		*** private function splitting "n" into the first "pos" chars ("a") and 
+		the rest ("b") in O(log n), takes over the reference of "n"
 		*/
-		string_base<T> &replace(const T &element, const T &replace, unsigned pos, unsigned count) {
-			if (pos >= len || len < (pos + count)) return (*this);
-			for (unsigned i = pos; i < (pos + count); i++)
-				if (raw_data[i] == element)
-					raw_data[i] = replace;
-			return (*this);
+		static void split(node *n, unsigned pos, node *&a, node *&b) {
+			if (!n) { a = b = NULL; return; }
+			if (!pos) { a = NULL; b = n; return; }
+			if (pos >= n->len) { a = n; b = NULL; return; }
+			if (n->leaf()) {
+				a = make_leaf(n->chunk.c_str(), pos);
+				b = make_leaf(n->chunk.c_str() + pos, n->len - pos);
+				release(n);
+				return;
+			}
+			node *l = retain(n->left), *r = retain(n->right);
+			release(n);
+			if (pos <= l->len) {
+				node *x, *y;
+				split(l, pos, x, y);
+				a = x;
+				b = join(y, r);
+			}
+			else {
+				node *x, *y;
+				split(r, pos - l->len, x, y);
+				a = join(l, x);
+				b = y;
+			}
+		}
+		/* private function inserting the tree "n" at "pos", takes over its reference */
+		rope &insert_node(unsigned pos, node *n) {
+			if (!n) return *this;
+			node *a, *b;
+			split(root, MIN(pos, length()), a, b);
+			root = join(join(a, n), b);
+			return *this;
 		}
+	}; /* TEMPLATE CLASS rope<T> */
 
-		void push_back(const T &ch) { append(ch); }									/* append ch's value to current value */
-		void push_back(const T *c_str) { append(c_str); }							/* append c_str's value to current value */	
-		void push_back(const string_base<T> &str) { append(str); }					/* append str's value to current value */
-#ifdef STR_USE_BINDINGS
-		void push_back(const std_string &str) { append(str); }						/* append std::basic_string value */
-#endif
-		void push_front(const T &ch) { insert(ch, 0); }								/* insert ch's value at string's front */
-		void push_front(const T *c_str) { insert(c_str, 0); }						/* insert c_str's value at string's front */
-		void push_front(const string_base<T> &str) { insert(str, 0); }				/* insert str's value at string's front */
-#ifdef STR_USE_BINDINGS
-		void push_front(const std_string &str) { insert(str, 0); }					/* insert std::basic_string value at front */
-#endif
-		void pop_back(unsigned count = 1) { erase(len - count, count); }			/* delete last "count" characters from string's back */	
-		void pop_front(unsigned count = 1) { erase(0, count); }						/* delete first "count" characters from string's front */
+	/*
+	*** TEMPLATE CLASS gap_buffer<T, Alloc, Growth>
+	*** string for cursor-local editing: the free capacity (the "gap") is kept 
+	at the position of the last edit, so inserting or erasing at the cursor is 
+	amortized O(1) and moving the edit position costs O(distance)
+	*** the cursor itself is moved in O(1), the gap follows it on the next edit
+	*** c_str() / view() move the gap to the end to materialize a contiguous 
+	null-terminated value (O(chars behind the gap)), the next edit moves it back;
+	they modify the buffer, so const access (safe for concurrent readers) goes 
+	through at(), front_part(), back_part() and flatten()
+	*** grows like string_base<T> (see growth policies), never shrinks
+	*** Added with Version 1.9
+	*/
+	template <typename T, typename Alloc = allocator<T>, typename Growth = STR_DEFGROWTH>
+	class gap_buffer : private Alloc {
+		typedef alloc_traits<Alloc> traits;
+	public:
 		/*
-		*** void reserve(unsigned)
-		*** reallocate string with new size of (cap += count)
-		*** doesn't touch data at all
-		*** Version 1.2: Add null-terminator at the end of array
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*** constructors
+		*** the cursor is placed at the end of the value
 		*/
-		void reserve(unsigned count = 1) {										
-			if (!count) return;
-			cap += count;
-			raw_data = (T *)realloc(raw_data, cap * sizeof(T));
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
-#endif
-			raw_data[cap] = 0x00;
+		explicit gap_buffer(const Alloc &alloc = Alloc()) : Alloc(alloc), buf(NULL), cap(0), gs(0), ge(0), cur(0) {}
+		explicit gap_buffer(const string_view_base<T> &sv, const Alloc &alloc = Alloc()) : Alloc(alloc), buf(NULL), cap(0), gs(0), ge(0), cur(0) {
+			insert(sv);
 		}
-		/* resize string to "count", fill possible new spaces with '\0' */
-		void resize(unsigned count) { resize(count, (T)'\0'); }
-		/*
-		*** void resize(unsigned, T)
-		*** resize string to a length of "count"
-		*** changes capacity to ("count" + 1), performs reallocation
-		*** if "count" > str.length(), fill new spaces with "ch"
-		*** Version 1.6: Added assertions to make debugging the program easier
-		*/
-		void resize(unsigned count, T ch) {
-			if (count == len) return;
-			if (count < len) {
-				len = count; cap = len + 1;
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
-#ifdef STR_USE_ASSERTIONS 
-				assert(raw_data != NULL);
-#endif
-				raw_data[len] = 0x00;
-			}
-			else if (count > len) {
-				unsigned o = len; len = count; cap = len + 1;
-				raw_data = (T *)realloc(raw_data, cap * sizeof(T));
-#ifdef STR_USE_ASSERTIONS 
-				assert(raw_data != NULL);
+		explicit gap_buffer(const T *c_str, const Alloc &alloc = Alloc()) : Alloc(alloc), buf(NULL), cap(0), gs(0), ge(0), cur(0) {
+			insert(string_view_base<T>(c_str));
+		}
+		template <typename A, typename G>
+		explicit gap_buffer(const string_base<T, A, G> &str, const Alloc &alloc = Alloc()) : Alloc(alloc), buf(NULL), cap(0), gs(0), ge(0), cur(0) {
+			insert(string_view_base<T>(str));
+		}
+		gap_buffer(const gap_buffer &obj) : Alloc(obj), buf(NULL), cap(0), gs(0), ge(0), cur(0) {
+			reserve(obj.length());
+			copy_to(obj, buf);
+			gs = obj.length();
+			cur = obj.cur;
+		}
+#ifdef STR_CPP11_OR_HIGHER
+		gap_buffer(gap_buffer &&obj) noexcept : Alloc(obj), buf(obj.buf), cap(obj.cap), gs(obj.gs), ge(obj.ge), cur(obj.cur) {
+			obj.buf = NULL;
+			obj.cap = obj.gs = obj.ge = obj.cur = 0;
+		}
+		gap_buffer &operator =(gap_buffer &&obj) noexcept { swap(obj); return *this; }
 #endif
-				for (unsigned i = o; i < count; i++)
-					raw_data[i] = ch;
-				raw_data[len] = 0x00;
+		gap_buffer &operator =(const gap_buffer &obj) {
+			if (this != &obj) {
+				gap_buffer tmp(obj);
+				swap(tmp);
 			}
+			return *this;
 		}
+		~gap_buffer() { if (buf) traits::deallocate(*this, buf, cap); }
+
+		/* exchange contents in constant time (the allocators are swapped too) */
+		void swap(gap_buffer &obj) {
+			Alloc a(*this); *(Alloc *)this = obj; *(Alloc *)&obj = a;
+			T *b = buf; buf = obj.buf; obj.buf = b;
+			unsigned t;
+			t = cap; cap = obj.cap; obj.cap = t;
+			t = gs; gs = obj.gs; obj.gs = t;
+			t = ge; ge = obj.ge; obj.ge = t;
+			t = cur; cur = obj.cur; obj.cur = t;
+		}
+
+		unsigned length() const { return cap - (ge - gs); }				/* returns number of chars */
+		unsigned size() const { return length() * sizeof(T); }			/* returns number of bytes */
+		bool empty() const { return !length(); }						/* checks whether the buffer is empty */
+		unsigned capacity() const { return cap ? cap - 1 : 0; }			/* returns number of chars that fit without reallocating */
+		unsigned cursor() const { return cur; }							/* returns the current edit position */
+
+		/* place the cursor at "pos" (clipped to the end) in O(1) */
+		void set_cursor(unsigned pos) { cur = MIN(pos, length()); }
+		/* move the cursor by "delta" chars (clipped to the value) in O(1) */
+		void move_cursor(int delta) {
+			if (delta < 0) cur -= MIN((unsigned)-delta, cur);
+			else set_cursor(cur + (unsigned)delta);
+		}
+
 		/*
-		*** void swap(string_base<T> &)
-		*** exchange contents of *this and "value"
-		*** Example: 
-			string a = "Pear", b = "Apple";
-			a.swap(b); 
-			// a is now "Apple" and b is now "Pear"
-		*** performs an assign operation internally
-		*** Version 1.2: fix function
-		*** Version 1.6: replace cleanup() with delete call
+		*** const T &at(unsigned) const
+		*** returns the char at "pos" in O(1) ("pos" has to be less than length())
+		*/
+		const T &at(unsigned pos) const { return buf[(pos < gs) ? pos : pos + (ge - gs)]; }
+		const T &operator [](unsigned pos) const { return at(pos); }
+
+		/*
+		*** void reserve(unsigned)
+		*** makes sure that "count" chars fit without reallocating
 		*/
-		void swap(string_base<T> &value) {
-			if (this == &value) return;
-			string_base<T> *tmp =
-				new string_base<T>(value);
-			value.assign(*this);
-			assign(*tmp);
-			delete tmp;
-		}
-		/* 
-		*** void reverse()
-		*** reverse string from pos 0 to end
-		*** from: https://www.geeksforgeeks.org/write-a-program-to-reverse-an-array-or-string/
+		void reserve(unsigned count) { if (count > capacity() || !cap) grow_gap(count - MIN(count, length())); }
+
+		/*
+		*** gap_buffer &insert(const T &)
+		*** inserts "ch" at the cursor and moves the cursor behind it (typing)
+		*** returns *this object
 		*/
-		void reverse() { reverse(0, len - 1); }			
+		gap_buffer &insert(const T &ch) {
+			if (ge - gs < 2) grow_gap(1);
+			move_gap(cur);
+			buf[gs++] = ch;
+			++cur;
+			return *this;
+		}
 		/*
-		*** void reverse(unsigned, unsigned)
-		*** reverses string's data from "start" to "end"
-		*** Example:
-			string a = "Hello world!";
-			a.reverse(0, a.length() - 1);
-			// a is now "!dlrow olleH"
-		*** doesn't touch size or capacity
+		*** gap_buffer &insert(const string_view_base<T> &)
+		*** inserts sv's value at the cursor and moves the cursor behind it (pasting)
+		*** returns *this object
 		*/
-		void reverse(unsigned start, unsigned end) {
-			if (start == end || len < 2 ||
-				end > (len - 1) ||
-				start > (len - 1)) return;
-			while (start < end) {
-				T tmp = raw_data[start];
-				raw_data[start] = raw_data[end];
-				raw_data[end] = tmp;
-				++start, --end;
+		gap_buffer &insert(const string_view_base<T> &sv) {
+			unsigned n = sv.length();
+			if (!n) return *this;
+			const T *src = sv.data();
+			if (src >= buf && src < buf + cap) {	/* part of this buffer, copy it first */
+				gap_buffer tmp(sv);
+				return insert(tmp.view());
 			}
+			if (ge - gs < n + 1) grow_gap(n);
+			move_gap(cur);
+			memcpy(buf + gs, src, n * sizeof(T));
+			gs += n;
+			cur += n;
+			return *this;
 		}
+		/* insert at "pos" (clipped to the end), the cursor is moved behind the inserted chars */
+		gap_buffer &insert(const T &ch, unsigned pos) { set_cursor(pos); return insert(ch); }
+		gap_buffer &insert(const string_view_base<T> &sv, unsigned pos) { set_cursor(pos); return insert(sv); }
+		gap_buffer &append(const string_view_base<T> &sv) { set_cursor(length()); return insert(sv); }
+
 		/*
-		*** void shrink()
-		*** shrink capacity to fit with len
-		*** performs a reallocation
-		*** doesn't touch string's data
-		*** Version 1.6: Added assertions to make debugging the program easier
+		*** gap_buffer &erase_before(unsigned) / erase_after(unsigned)
+		*** erase up to "count" chars in front of (backspace) or behind (delete) 
+		the cursor by widening the gap, no chars are moved except to bring 
+		the gap to the cursor
+		*** returns *this object
 		*/
-		void shrink() {
-			if (cap == (len + 1)) return;
-			cap = len + 1;
-			raw_data = (T *)realloc(raw_data, cap * sizeof(T));
-#ifdef STR_USE_ASSERTIONS 
-			assert(raw_data != NULL);
-#endif
-			raw_data[len] = 0x00;
+		gap_buffer &erase_before(unsigned count = 1U) {
+			count = MIN(count, cur);
+			if (!count) return *this;
+			move_gap(cur);
+			gs -= count;
+			cur -= count;
+			return *this;
 		}
+		gap_buffer &erase_after(unsigned count = 1U) {
+			count = MIN(count, length() - cur);
+			if (!count) return *this;
+			move_gap(cur);
+			ge += count;
+			return *this;
+		}
+		/* erase "count" chars starting at "pos" (clipped to the end), the cursor is placed at "pos" */
+		gap_buffer &erase(unsigned pos, unsigned count = 1U) { set_cursor(pos); return erase_after(count); }
+		/* erase all chars, the capacity is kept */
+		void clear() { gs = cur = 0; ge = cap; }
+
 		/*
-		*** void clear()
-		*** clear string (destroy all chars)
-		*** doesn't touch capacity, performs a reallocation
-		*** sets first char to 0x00
+		*** const T *c_str()
+		*** returns the value as null-terminated C-String by moving the gap to 
+		the end, valid until the next edit
+		*** non-const since it rearranges the buffer, use flatten() on const objects
 		*/
-		void clear() {
-			delete[] raw_data;
-			raw_data = new T[cap];
-			raw_data[0] = 0x00;
-			len = 0;
+		const T *c_str() {
+			if (!buf) return empty_str();
+			move_gap(length());
+			buf[gs] = T();
+			return buf;
 		}
+		/* view of the whole value (see c_str()), valid until the next edit */
+		string_view_base<T> view() { const T *s = c_str(); return string_view_base<T>(s, length()); }
+		/* views of the chars in front of and behind the gap, without moving anything */
+		string_view_base<T> front_part() const { return buf ? string_view_base<T>(buf, gs) : string_view_base<T>(); }
+		string_view_base<T> back_part() const { return buf ? string_view_base<T>(buf + ge, cap - ge) : string_view_base<T>(); }
+
 		/*
-		*** void reset()
-		*** set string's allocation state tback to default 
-		*** most likely deallocates array and makes it ready for a reuse
-		*** All data is lost, so only do it when you really want it
+		*** string_base<T, Alloc, Growth> flatten() const
+		*** returns a copy of the value (exactly one allocation, the gap stays where it is)
 		*/
-		void reset() {
-			delete[] raw_data;
-			raw_data = new T[STR_DEFSTRCAP];
-			raw_data[0] = 0x00;
-			len = 0; cap = STR_DEFSTRCAP;
+		string_base<T, Alloc, Growth> flatten() const {
+			string_base<T, Alloc, Growth> res(length() + 1, *this);
+			res.append(front_part());
+			res.append(back_part());
+			return res;
 		}
 
-#ifdef STR_USE_CLEANUP_FUNCTION
+	private:
+		T *buf;					/* storage, [0, gs) and [ge, cap) hold the value */
+		unsigned cap;			/* number of allocated chars */
+		unsigned gs;			/* gap start */
+		unsigned ge;			/* gap end */
+		unsigned cur;			/* cursor, the position of the next edit */
+
+		static const T *empty_str() {
+			static const T e = T();
+			return &e;
+		}
+		/* private function moving the gap to logical position "pos" (O(distance)) */
+		void move_gap(unsigned pos) {
+			if (pos < gs) {
+				unsigned n = gs - pos;
+				memmove(buf + ge - n, buf + pos, n * sizeof(T));
+				gs -= n; ge -= n;
+			}
+			else if (pos > gs) {
+				unsigned n = pos - gs;
+				memmove(buf + gs, buf + ge, n * sizeof(T));
+				gs += n; ge += n;
+			}
+		}
+		/* private function copying the value of "obj" contiguously to "dst" */
+		static void copy_to(const gap_buffer &obj, T *dst) {
+			if (!obj.buf) return;
+			memcpy(dst, obj.buf, obj.gs * sizeof(T));
+			memcpy(dst + obj.gs, obj.buf + obj.ge, (obj.cap - obj.ge) * sizeof(T));
+		}
 		/*
-		*** void cleanup()
-		*** custom destructor you can call if you 
-		want to deallocate the memory used by this string object
-		*** this object and all of its members will be invalided after calling this function
-		*** All data is lost when calling this 
-		*** Version 1.1: add this function and remove default destructor
-		*** Version 1.5: define STR_USE_CLEANUP_FUNCTION to enable this function
+		*** private function making room for "count" more chars (plus one char 
+		for the null-terminator of c_str()), the gap is placed at the end
 		*/
-		void cleanup() {
-			delete[] raw_data;
-	#ifdef CPP11_OR_HIGHER
-			/* nullptr is a typesafe alternative to NULL */
-			raw_data = nullptr;
-	#else
-			/* C++98 support by avoiding nullptr */
-			raw_data = NULL;
-	#endif
-			delete this;
+		void grow_gap(unsigned count) {
+			unsigned l = length();
+			unsigned n = Growth::grow(cap, l + count + 1, sizeof(T));
+			T *res = traits::allocate(*this, n);
+			copy_to(*this, res);
+			if (buf) traits::deallocate(*this, buf, cap);
+			buf = res;
+			cap = n;
+			gs = l;
+			ge = n;
+		}
+	}; /* TEMPLATE CLASS gap_buffer<T> */
+
+	/*
+	*** TEMPLATE CLASS string_builder<T, Alloc>
+	*** collects fragments in a chain of chunks of STR_BUILDERCHUNK chars 
+	instead of one growing buffer, an append never moves chars that are 
+	already stored (no realloc() copies)
+	*** the chunks can be written out directly (scatter/gather output, see 
+	chunk()) or joined by str() with one exact-size allocation and one copy
+	*** clear() keeps all chunks, so a builder kept per thread stops allocating 
+	once it has seen its largest output; reserve() preallocates for a known size
+	*** chunks are allocated through "Alloc", the chunk table with malloc()
+	*** Added with Version 1.9
+	*/
+	template <typename T, typename Alloc = allocator<T> >
+	class string_builder : private Alloc {
+		typedef alloc_traits<Alloc> traits;
+	public:
+		/* create an empty builder, no memory is allocated before the first append */
+		explicit string_builder(unsigned chunk_size = STR_BUILDERCHUNK, const Alloc &alloc = Alloc())
+			: Alloc(alloc), chunks(NULL), count(0), used(0), len(0), chunk_size(chunk_size ? chunk_size : 1) {}
+		/* free all chunks */
+		~string_builder() { release(); }
+
+		unsigned length() const { return len; }							/* returns number of chars */
+		unsigned size() const { return len * sizeof(T); }				/* returns number of bytes */
+		bool empty() const { return !len; }								/* checks whether the builder is empty */
+		unsigned chunk_count() const { return used; }					/* returns number of chunks holding chars */
+		/* returns the chars of chunk "i" (i < chunk_count()), valid until the next append, clear() or release() */
+		string_view_base<T> chunk(unsigned i) const { return string_view_base<T>(chunks[i].data, chunks[i].len); }
+		/* returns number of chars that can be appended without allocating */
+		unsigned capacity() const {
+			unsigned n = used ? chunks[used - 1].cap - chunks[used - 1].len : 0;
+			for (unsigned i = used; i < count; i++) n += chunks[i].cap;
+			return n;
 		}
-#endif
 
 		/*
-		*********************************************************************************
-		*** OPERATOR OVERLOADS														  ***
-		*********************************************************************************
-		*** The code below defines some functions to convert string to several arithmetic types
-		*** Added in Version 1.4
-		*** supported types:
-			-> long								[stol]
-			-> long long (_ll_)					[stoll]
-			-> unsigned long (_ul_)				[stoul]
-			-> unsigned long long (_ull_)		[stoull]
-			-> float							[stof]
-			-> double							[stod]
-			-> long double (_ld_)				[stold]
+		*** string_builder<T> &append(const T *, unsigned)
+		*** appends "count" chars at "data", filling the current chunk first
+		*** a new chunk holds at least the rest of the fragment
+		*** returns (modified) *this object
 		*/
+		string_builder &append(const T *data, unsigned count) {
+			if (used && count <= chunks[used - 1].cap - chunks[used - 1].len) {	/* fits into the current chunk */
+				chunk_t &c = chunks[used - 1];
+				memcpy(c.data + c.len, data, count * sizeof(T));
+				c.len += count;
+				len += count;
+				return *this;
+			}
+			while (count) {
+				if (!used || chunks[used - 1].len == chunks[used - 1].cap) next_chunk(count);
+				chunk_t &c = chunks[used - 1];
+				unsigned k = MIN(count, c.cap - c.len);
+				memcpy(c.data + c.len, data, k * sizeof(T));
+				c.len += k;
+				len += k;
+				data += k;
+				count -= k;
+			}
+			return *this;
+		}
+		string_builder &append(const T *c_str) { unsigned l = 0; while (c_str[l]) ++l; return append(c_str, l); }	/* append a C-String */
+		string_builder &append(const string_view_base<T> &sv) { return append(sv.data(), sv.length()); }			/* append the chars of a view */
+		template <typename A, typename G>
+		string_builder &append(const string_base<T, A, G> &str) { return append(str.c_str(), str.length()); }	/* append the value of a string */
+		/* append a single char */
+		string_builder &append(const T &ch) {
+			if (!used || chunks[used - 1].len == chunks[used - 1].cap) next_chunk(1);
+			chunk_t &c = chunks[used - 1];
+			c.data[c.len++] = ch;
+			len++;
+			return *this;
+		}
+		/* append the text of an integer (see string_base<T>::append_number()) */
+		template <typename N>
+		string_builder &append_number(N value) {
+			T buf[24];
+			bool neg = numeric::sign_of<numeric::int_limits<N>::is_signed != 0>::negative(value);
+			_ull_ v = neg ? (_ull_)0 - (_ull_)value : (_ull_)value;
+			unsigned n = numeric::count_digits(v);
+			numeric::write_uint(buf + 24, v);
+			if (neg) buf[23 - n++] = T('-');
+			return append(buf + 24 - n, n);
+		}
+		/* append the shortest round-trip text of a float or double (see string_base<T>::append_number()) */
+		string_builder &append_number(float value) { T buf[32]; return append(buf, numeric::format_float(buf, value)); }
+		string_builder &append_number(double value) { T buf[32]; return append(buf, numeric::format_float(buf, value)); }
 
-		long stol() const { char *x = new char[len]; for (_u_ i = 0; i < len; i++) x[i] = raw_data[i] & 0x7F; long r = strtol(x, NULL, 10); delete[] x; return r; }			/* -> long */
-		_ll_ stoll() const { char *x = new char[len]; for (_u_ i = 0; i < len; i++) x[i] = raw_data[i] & 0x7F; _ll_ r = strtoll(x, NULL, 10); delete[] x; return r; }			/* -> long long */
-		_ul_ stoul() const { char *x = new char[len]; for (_u_ i = 0; i < len; i++) x[i] = raw_data[i] & 0x7F; _ul_ r = strtoul(x, NULL, 10); delete[] x; return r; }			/* -> unsigned long */
-		_ull_ stoull() const { char *x = new char[len]; for (_u_ i = 0; i < len; i++) x[i] = raw_data[i] & 0x7F; _ull_ r = strtoull(x, NULL, 10); delete[] x; return r; }		/* -> unsigned long long */
-		float stof() const { char *x = new char[len]; for (_u_ i = 0; i < len; i++) x[i] = raw_data[i] & 0x7F; float r = strtof(x, NULL); delete[] x; return r; }				/* -> float */
-		double stod() const { char *x = new char[len]; for (_u_ i = 0; i < len; i++) x[i] = raw_data[i] & 0x7F; double r = strtod(x, NULL); delete[] x; return r; }			/* -> double */
-		_ld_ stold() const { char *x = new char[len]; for (_u_ i = 0; i < len; i++) x[i] = raw_data[i] & 0x7F; _ld_ r = strtold(x, NULL); delete[] x; return r; }				/* -> long double */
+		string_builder &operator +=(const T &ch) { return append(ch); }							/* append ch's value */
+		string_builder &operator +=(const T *c_str) { return append(c_str); }					/* append c_str's value */
+		string_builder &operator +=(const string_view_base<T> &sv) { return append(sv); }		/* append the chars of a view */
+		template <typename A, typename G>
+		string_builder &operator +=(const string_base<T, A, G> &str) { return append(str); }	/* append str's value */
 
 		/*
-		*********************************************************************************
-		*** OPERATOR OVERLOADS														  ***
-		*********************************************************************************
-		*** Code below overloads some operators to create some pretty shortcuts of some 
-		function calls
+		*** void reserve(unsigned)
+		*** hint that "count" more chars will be appended: makes sure they fit 
+		into the chunks without further allocations (allocates one chunk at most)
 		*/
+		void reserve(unsigned count) {
+			unsigned n = capacity();
+			if (n >= count) return;
+			add_chunk(MAX(count - n, chunk_size));
+		}
+		/* remove all chars, keep the chunks for reuse */
+		void clear() {
+			for (unsigned i = 0; i < used; i++) chunks[i].len = 0;
+			used = 0;
+			len = 0;
+		}
+		/* free all chunks, the builder can be used again afterwards */
+		void release() {
+			for (unsigned i = 0; i < count; i++) traits::deallocate(*this, chunks[i].data, chunks[i].cap);
+			free(chunks);
+			chunks = NULL;
+			count = used = len = 0;
+		}
 
 		/*
-		*** T &operator [](unsigned)
-		*** return a reference to the char which is at position "pos"
-		*** usage: 
-		***		string a = "Hello world!";
-		***		a[0] = 'Y';						-> change first char of "a" to 'Y'
-		*** can be used to output the character at position "pos" as well
- 		*/	
-		T &operator [](unsigned pos) { return raw_data[(pos > (len - 1) ? (len - 1) : pos)]; }
-		/*
-		*** const T &operator [](unsigned) const
-		*** return a reference to the char which is at position "pos"
-		*** can be used to output the character at position "pos" as well
-		*** if current string value is const-qualified, it returns this function when
-		"operator[]" is called outside of the class
+		*** string_base<T> str() const
+		*** returns the value as one contiguous string (exactly one allocation)
 		*/
-		const T &operator [](unsigned pos) const { return raw_data[(pos > (len - 1) ? (len - 1) : pos)]; }
-
-		string_base<T> &operator =(const T &ch) { return assign(ch, 1); }					/* assign ch's value to current string value */
-		string_base<T> &operator =(const T *c_str) { return assign(c_str); }				/* assign c_str's value to current string value */
-		string_base<T> &operator =(const string_base<T> &str) { return assign(str); }		/* assign a str's value to current string value */
-#ifdef STR_USE_BINDINGS
-		string_base<T> &operator =(const std_string &str) { return assign(str); }			/* assign std::basic_string value to current string */
-#endif
+		string_base<T> str() const {
+			string_base<T> res(len + 1);
+			for (unsigned i = 0; i < used; i++) res.append(chunk(i));
+			return res;
+		}
+		/* copies the value to "out" (length() chars, no null-terminator) */
+		void copy(T *out) const {
+			for (unsigned i = 0; i < used; i++) {
+				memcpy(out, chunks[i].data, chunks[i].len * sizeof(T));
+				out += chunks[i].len;
+			}
+		}
 
-		string_base<T> &operator +=(const T &ch) { return append(ch); }						/* append (concatenate) ch's value to current string value */
-		string_base<T> &operator +=(const T *c_str) { return append(c_str); }				/* append c_str's value to current string value */
-		string_base<T> &operator +=(const string_base<T> &str) { return append(str); }		/* append str's value to current string value */
-#ifdef STR_USE_BINDINGS
-		string_base<T> &operator +=(const std_string &str) { return append(str); }			/* append std::basic_string value to current string */
-#endif
+	private:
+		struct chunk_t {
+			T *data;		/* chars (allocated through "Alloc") */
+			unsigned len;	/* chars in use */
+			unsigned cap;	/* chars allocated */
+		};
 
-		string_base<T> &operator -=(const T &ch) { return remove(ch); }						/* remove all characters which equal to ch's value from current string */
+		chunk_t *chunks;		/* chunk table, [0, used) hold chars, [used, count) are empty */
+		unsigned count;			/* allocated chunks */
+		unsigned used;			/* chunks in use, the last one is filled */
+		unsigned len;			/* total number of chars */
+		unsigned chunk_size;	/* minimum size of a new chunk */
 
-		string_base<T> &operator ~() { reverse(); return *this; }							/* operator overload to reverse string */
+		/* builders own their chunks, copying one makes no sense */
+		string_builder(const string_builder &);
+		string_builder &operator =(const string_builder &);
 
-		bool operator ==(const T *c_str) { return compare(c_str) == 0; }					/* check whether *this == c_str */
-		bool operator ==(const string_base<T> &right) { return compare(right) == 0; }		/* check whether *this == right */
-#ifdef STR_USE_BINDINGS
-		bool operator ==(const std_string &right) { return compare(right) == 0; }			/* check whether *this == right (std::basic_string) */
+		/* allocate an empty chunk of "cap" chars at the end of the table */
+		void add_chunk(unsigned cap) {
+			chunks = (chunk_t *)realloc(chunks, (count + 1) * sizeof(chunk_t));
+#ifdef STR_USE_ASSERTIONS 
+			assert(chunks != NULL);
 #endif
-
-		bool operator !=(const T *c_str) { return compare(c_str) != 0; }					/* check whether *this != c_str */
-		bool operator !=(const string_base<T> &right) { return compare(right) != 0; }		/* check whether *this != right */
-#ifdef STR_USE_BINDINGS
-		bool operator !=(const std_string &right) { return compare(right) != 0; }			/* check whether *this != right (std::basic_string) */
+			chunk_t &c = chunks[count++];
+			c.data = traits::allocate(*this, cap);
+#ifdef STR_USE_ASSERTIONS 
+			assert(c.data != NULL);
 #endif
+			c.len = 0;
+			c.cap = cap;
+		}
+		/* continue with the next empty chunk, allocates one of at least "hint" chars if there is none */
+		void next_chunk(unsigned hint) {
+			if (used == count) add_chunk(MAX(hint, chunk_size));
+			used++;
+		}
+	}; /* TEMPLATE CLASS string_builder<T> */
 
-		/*
-		*********************************************************************
-		*** string comparison table										  ***
-		*********************************************************************
+	template <typename T> class intern_pool;
 
-		compared string = *this
+	/*
+	*** TEMPLATE CLASS interned_base<T>
+	*** handle of a string stored in an intern_pool<T> (one pointer)
+	*** handles of the same pool are equal if and only if their values are 
+	equal, so ==, != and hash() are O(1) (the hash value is stored in the pool)
+	*** hash() equals string_base<T>::hash() of the same value
+	*** < orders by address, not lexicographically (for sorted containers)
+	*** a default constructed handle is the empty string (interning "" returns it, too)
+	*** valid as long as the pool exists, the chars never move
+	*** Added with Version 1.9
+	*/
+	template <typename T>
+	class interned_base {
+		friend class intern_pool<T>;
+	public:
+		interned_base() : e(NULL) {}
 
-		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-		*     * Either the value of the first character that does not		*
-		* <0  * match is lower in the compared string, or all compared		*
-		*     * characters match but the compared string is shorter.		*
-		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-		*     *																*
-		* =0  * They compare equal (so str1 == str2).						*
-		*     *																*
-		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-		*     * Either the value of the first character that does not		*
-		* >0  * match is greater in the compared string, or all compared	*
-		*     * characters match but the compared string is longer.			*
-		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-		* from: http://www.cplusplus.com/reference/string/string/compare/	*														
-		* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-		*/
+		const T *c_str() const { return e ? chars(e) : empty_str(); }		/* returns null-terminated value */
+		const T *data() const { return c_str(); }							/* returns pointer to the first char */
+		unsigned length() const { return e ? e->len : 0; }					/* returns number of chars */
+		bool empty() const { return !e; }									/* checks whether the value is empty */
+		_ull_ hash() const { return e ? e->hash : hash_bytes(NULL, 0); }	/* returns stored hash value */
+		string_view_base<T> view() const { return string_view_base<T>(c_str(), length()); }	/* returns view of the value */
+		operator string_view_base<T>() const { return view(); }
 
-		inline bool operator >(const T *c_str) { return compare(c_str) > 0; }				/* check whether *this > c_str */
-		inline bool operator <(const T *c_str) { return compare(c_str) < 0; }				/* check whether *this < c_str */
-		inline bool operator >=(const T *c_str) { return compare(c_str) >= 0; }				/* check whether *this >= c_str */
-		inline bool operator <=(const T *c_str) { return compare(c_str) <= 0; }				/* check whether *this <= c_str */
+		bool operator ==(const interned_base &h) const { return e == h.e; }
+		bool operator !=(const interned_base &h) const { return e != h.e; }
+		bool operator <(const interned_base &h) const { return e < h.e; }
 
-		inline bool operator >(const string_base<T> &str) { return compare(str) > 0; }		/* check whether *this > str */
-		inline bool operator <(const string_base<T> &str) { return compare(str) < 0; }		/* check whether *this < str */
-		inline bool operator >=(const string_base<T> &str) { return compare(str) >= 0; }	/* check whether *this >= str */
-		inline bool operator <=(const string_base<T> &str) { return compare(str) <= 0; }	/* check whether *this <= str */
+	private:
+		/* pool entry, the null-terminated chars follow directly after it */
+		struct entry {
+			_ull_ hash;
+			unsigned len;
+		};
+		const entry *e;
 
-#ifdef STR_USE_BINDINGS
-		inline bool operator >(const std_string &str) { return compare(str) > 0; }			/* check whether *this > str */
-		inline bool operator <(const std_string &str) { return compare(str) < 0; }			/* check whether *this < str */
-		inline bool operator >=(const std_string &str) { return compare(str) >= 0; }		/* check whether *this >= str */
-		inline bool operator <=(const std_string &str) { return compare(str) <= 0; }		/* check whether *this <= str */
+		explicit interned_base(const entry *e) : e(e) {}
+		static const T *chars(const entry *e) { return (const T *)(const void *)(e + 1); }
+		static const T *empty_str() {
+			static const T z = T();
+			return &z;
+		}
+	};
+
+	typedef interned_base<char> interned_string;				/* handle of an interned string */
+	typedef interned_base<wchar_t> interned_wstring;			/* handle of an interned wide string */
+#ifdef STR_CPP11_OR_HIGHER
+	typedef interned_base<char16_t> interned_string16;			/* handle of an interned UTF-16 string */
+	typedef interned_base<char32_t> interned_string32;			/* handle of an interned UTF-32 string */
 #endif
 
-		/* end of public segment */
-	private:
-		T *raw_data;		/* actual character (string) storage */
-		unsigned len, cap;	/* len = length of string / cap = capacity of string */
+	/*
+	*** TEMPLATE CLASS intern_pool<T>
+	*** deduplicates string values into immutable storage, every distinct 
+	value is stored once and represented by an interned_base<T> handle
+	*** the pool is split into STR_INTERNSHARDS shards (chosen by the hash 
+	value), each one with its own hash table (open addressing), str::arena 
+	for the chars and lock, so threads interning different values rarely wait 
+	for each other (thread-safe with C++11 or higher only, std::mutex)
+	*** values are never removed, all handles stay valid until the pool is destroyed
+	*** Added with Version 1.9
+	*/
+	template <typename T>
+	class intern_pool {
+		typedef typename interned_base<T>::entry entry;
+	public:
+		typedef interned_base<T> handle;	/* handle type */
+
+		/* create an empty pool, no memory is allocated before the first value is stored */
+		intern_pool() {}
+		~intern_pool() {
+			for (unsigned i = 0; i < (unsigned)STR_INTERNSHARDS; i++)
+				free(shards[i].table);
+		}
 
 		/*
-		*** private function which is used to get the 
-		length of str's C-String value with value_type "T_"
-		*** only used within the class, not outside 
-		(and also not reachable from outside the class)
+		*** handle intern(const string_view_base<T> &)
+		*** returns the handle of sv's value, stores a copy of it if it's new
+		*** takes C-Strings and string_base<T> objects as well (converted to views)
 		*/
-		template <typename T_>
-		static unsigned strlength(const T_ *c_str) {
-			/* return 0 if first char is null-terminator */
-			if (!*c_str) return 0;
-			unsigned res = 0;
-			for (; c_str[res] != 0x00; res++);
-			return res;
+		handle intern(const string_view_base<T> &sv) {
+			if (sv.empty()) return handle();
+			_ull_ h = hash_bytes(sv.data(), sv.size());
+			shard &s = shard_of(h);
+			lock l(s);
+			return handle(s.insert(sv.data(), sv.length(), h));
+		}
+		/*
+		*** handle find(const string_view_base<T> &)
+		*** returns the handle of sv's value if it has been interned already, 
+		the empty handle otherwise (never stores anything)
+		*/
+		handle find(const string_view_base<T> &sv) {
+			if (sv.empty()) return handle();
+			_ull_ h = hash_bytes(sv.data(), sv.size());
+			shard &s = shard_of(h);
+			lock l(s);
+			return handle(s.lookup(sv.data(), sv.length(), h));
 		}
 
 		/*
-		*** private function to fill string buffer
-		*** (uses a memset-like algorithm)
-		*** works with every template type 
-		(memset has problems with char32_t, 
-		therefore I made a similar function. It
-		is currently unused but may be used for other 
-		functions in the future)
-		*** returns dest (parameter 1)
+		*** void intern_all(const S *, unsigned, handle *)
+		*** interns "count" values at once and writes their handles to "out"
+		*** "S" may be anything convertible to string_view_base<T> (views, 
+		C-Strings, string_base<T>, ...)
+		*** hashes all values first and locks every shard only once, growing 
+		its table for the whole batch in advance
 		*/
-		template <typename T__>
-		static T__ *fill_str(T__ *dest, const T__ &val, _u_ len) {
-			register const T__ *p = dest;
-			while (len-- > 0) *p++ = val;
-			return dest;
+		template <typename S>
+		void intern_all(const S *in, unsigned count, handle *out) {
+			if (!count) return;
+			_ull_ *hs = (_ull_ *)malloc(count * sizeof(_ull_));
+			unsigned *order = (unsigned *)malloc(count * sizeof(unsigned));
+			unsigned start[STR_INTERNSHARDS + 1] = { 0 };
+#ifdef STR_USE_ASSERTIONS 
+			assert(hs != NULL && order != NULL);
+#endif
+			/* hash everything and sort the indices by shard (counting sort) */
+			for (unsigned i = 0; i < count; i++) {
+				string_view_base<T> sv(in[i]);
+				hs[i] = hash_bytes(sv.data(), sv.size());
+				start[shard_index(hs[i]) + 1]++;
+			}
+			for (unsigned i = 0; i < (unsigned)STR_INTERNSHARDS; i++) start[i + 1] += start[i];
+			for (unsigned i = 0; i < count; i++) order[start[shard_index(hs[i])]++] = i;
+			for (unsigned i = (unsigned)STR_INTERNSHARDS; i > 0; i--) start[i] = start[i - 1];
+			start[0] = 0;
+
+			for (unsigned i = 0; i < (unsigned)STR_INTERNSHARDS; i++) {
+				if (start[i] == start[i + 1]) continue;
+				shard &s = shards[i];
+				lock l(s);
+				s.reserve(s.count + (start[i + 1] - start[i]));
+				for (unsigned j = start[i]; j < start[i + 1]; j++) {
+					unsigned k = order[j];
+					string_view_base<T> sv(in[k]);
+					out[k] = sv.empty() ? handle() : handle(s.insert(sv.data(), sv.length(), hs[k]));
+				}
+			}
+			free(order);
+			free(hs);
 		}
 
-		/* end of private segment */
-	}; /* TEMPLATE CLASS string_base<T> */
+		/* returns number of distinct values stored */
+		unsigned size() {
+			unsigned n = 0;
+			for (unsigned i = 0; i < (unsigned)STR_INTERNSHARDS; i++) {
+				lock l(shards[i]);
+				n += shards[i].count;
+			}
+			return n;
+		}
+		/* returns number of bytes used for the values (entries and chars, without the tables) */
+		unsigned bytes() {
+			unsigned n = 0;
+			for (unsigned i = 0; i < (unsigned)STR_INTERNSHARDS; i++) {
+				lock l(shards[i]);
+				n += shards[i].mem.used();
+			}
+			return n;
+		}
 
-	typedef string_base<char> string;				/* normal string (value_type = char) */
-	typedef string_base<wchar_t> wstring;			/* wide string (value_type = wchar_t) */
-/* only add string16 and string32 if C++11 or higher is supported */
+	private:
+		/* one part of the pool: hash table of entries, their storage and the lock */
+		struct shard {
+			const entry **table;	/* open addressing, NULL = free slot */
+			unsigned mask;			/* table size - 1 (power of two) */
+			unsigned count;			/* number of entries */
+			arena mem;				/* storage of the entries */
 #ifdef STR_CPP11_OR_HIGHER
-	typedef string_base<char16_t> string16;			/* UTF-16 string (value_type = char16_t) */
-	typedef string_base<char32_t> string32;			/* UTF-32 string (value_type = char32_t) */
+			std::mutex mtx;
+#endif
+			shard() : table(NULL), mask(0), count(0) {}
+
+			const entry *lookup(const T *data, unsigned len, _ull_ h) const {
+				if (!table) return NULL;
+				for (unsigned i = (unsigned)h & mask; table[i]; i = (i + 1) & mask) {
+					const entry *e = table[i];
+					if (e->hash == h && e->len == len && !memcmp(handle::chars(e), data, len * sizeof(T)))
+						return e;
+				}
+				return NULL;
+			}
+			const entry *insert(const T *data, unsigned len, _ull_ h) {
+				const entry *e = lookup(data, len, h);
+				if (e) return e;
+				reserve(count + 1);
+				entry *n = (entry *)mem.allocate(sizeof(entry) + (len + 1) * sizeof(T), sizeof(_ull_));
+#ifdef STR_USE_ASSERTIONS 
+				assert(n != NULL);
+#endif
+				n->hash = h;
+				n->len = len;
+				T *c = (T *)(void *)(n + 1);
+				memcpy(c, data, len * sizeof(T));
+				c[len] = 0x00;
+				unsigned i = (unsigned)h & mask;
+				while (table[i]) i = (i + 1) & mask;
+				table[i] = n;
+				count++;
+				return n;
+			}
+			/* make room for "n" entries (the table is kept at most half full) */
+			void reserve(unsigned n) {
+				unsigned size = table ? mask + 1 : 0;
+				if (n * 2 <= size) return;
+				unsigned ns = size ? size : 64;
+				while (ns < n * 2) ns *= 2;
+				const entry **nt = (const entry **)calloc(ns, sizeof(const entry *));
+#ifdef STR_USE_ASSERTIONS 
+				assert(nt != NULL);
+#endif
+				for (unsigned i = 0; i < size; i++) {
+					if (!table[i]) continue;
+					unsigned j = (unsigned)table[i]->hash & (ns - 1);
+					while (nt[j]) j = (j + 1) & (ns - 1);
+					nt[j] = table[i];
+				}
+				free(table);
+				table = nt;
+				mask = ns - 1;
+			}
+		};
+		/* scoped lock of a shard (does nothing without C++11) */
+		struct lock {
+#ifdef STR_CPP11_OR_HIGHER
+			std::lock_guard<std::mutex> g;
+			explicit lock(shard &s) : g(s.mtx) {}
+#else
+			explicit lock(shard &) {}
 #endif
+		};
+
+		shard shards[STR_INTERNSHARDS];
+
+		/* the shard is chosen by the upper bits, the table slot by the lower ones */
+		static unsigned shard_index(_ull_ h) { return (unsigned)(h >> 40) % (unsigned)STR_INTERNSHARDS; }
+		shard &shard_of(_ull_ h) { return shards[shard_index(h)]; }
+
+		/* pools own their storage, copying one makes no sense */
+		intern_pool(const intern_pool &);
+		intern_pool &operator =(const intern_pool &);
+	}; /* TEMPLATE CLASS intern_pool<T> */
 
 /*
 *** the following operator overloads for >> and << are supposed to allow direct input
 *** and output using the std:: input/output streams (cin and cout for example)
 *** (Some of them are only available in C++ and newer since char16_t and char32_t 
 *** didn't even exist in older standards)
+*** Version 1.9: >> reads a whole line (not limited to the current capacity anymore)
 */
 #ifdef STR_USE_BINDINGS
-	std_ostream &operator <<(std_ostream &stream, str::string &str) { return stream << str.c_str(); }									/* handle ostream output with str::string  */
-	std_wostream &operator <<(std_wostream &stream, str::wstring &str) { return stream << str.c_str(); }								/* handle ostream output with str::wstring */
-	std_istream &operator >>(std_istream &stream, str::string &str) { return stream.get(str.data(), str.capacity()); }					/* handle istream input with str::string32 */
-	std_wistream &operator >>(std_wistream &stream, str::wstring &str) { return stream.get(str.data(), str.capacity()); }				/* handle istream input with str::string16 */
+	inline std_ostream &operator <<(std_ostream &stream, str::string &str) { return stream << str.c_str(); }									/* handle ostream output with str::string  */
+	inline std_wostream &operator <<(std_wostream &stream, str::wstring &str) { return stream << str.c_str(); }								/* handle ostream output with str::wstring */
+	inline std_istream &operator >>(std_istream &stream, str::string &str) { str::string::std_string s; std::getline(stream, s); str.assign(s); return stream; }				/* handle istream input with str::string */
+	inline std_wistream &operator >>(std_wistream &stream, str::wstring &str) { str::wstring::std_string s; std::getline(stream, s); str.assign(s); return stream; }			/* handle istream input with str::wstring */
 	#ifdef STR_CPP11_OR_HIGHER
-		std_c16ostream &operator <<(std_c16ostream &stream, str::string16 &str) { return stream << str.c_str(); }						/* handle ostream output with str::string16 */
-		std_c32ostream &operator <<(std_c32ostream &stream, str::string32 &str) { return stream << str.c_str(); }						/* handle ostream output with str::string32 */
-		std_c16istream &operator >>(std_c16istream &stream, str::string16 &str) { return stream.get(str.data(), str.capacity()); }		/* handle istream input with str::string16  */
-		std_c32istream &operator >>(std_c32istream &stream, str::string32 &str) { return stream.get(str.data(), str.capacity()); }		/* handle istream input with str::string32  */
+		inline std_c16ostream &operator <<(std_c16ostream &stream, str::string16 &str) { return stream << str.c_str(); }						/* handle ostream output with str::string16 */
+		inline std_c32ostream &operator <<(std_c32ostream &stream, str::string32 &str) { return stream << str.c_str(); }						/* handle ostream output with str::string32 */
+		inline std_c16istream &operator >>(std_c16istream &stream, str::string16 &str) { str::string16::std_string s; std::getline(stream, s); str.assign(s); return stream; }	/* handle istream input with str::string16  */
+		inline std_c32istream &operator >>(std_c32istream &stream, str::string32 &str) { str::string32::std_string s; std::getline(stream, s); str.assign(s); return stream; }	/* handle istream input with str::string32  */
 	#endif
 #endif
 
 }; /* namespace "str" */
 
+/*
+*** std::hash<> for every string_base<T>, so strings can be used as keys of 
+std::unordered_map and std::unordered_set directly
+(string_view_base<T> and interned_base<T> as well)
+*** Added with Version 1.9
+*/
+#ifdef STR_CPP11_OR_HIGHER
+namespace std {
+	template <typename T, typename Alloc, typename Growth>
+	struct hash<str::string_base<T, Alloc, Growth>> {
+		size_t operator ()(const str::string_base<T, Alloc, Growth> &s) const noexcept { return (size_t)s.hash(); }
+	};
+	template <typename T>
+	struct hash<str::string_view_base<T>> {
+		size_t operator ()(const str::string_view_base<T> &s) const noexcept { return (size_t)s.hash(); }
+	};
+	template <typename T>
+	struct hash<str::interned_base<T>> {
+		size_t operator ()(const str::interned_base<T> &s) const noexcept { return (size_t)s.hash(); }
+	};
+}
+#endif
+
 #endif /* ifdef __cplusplus */
 
 #endif /* STRING_H */